@@ -15,6 +15,161 @@ struct _VuiOpenGLState {
 
 static _VuiOpenGLState _vui_opengl_state = {0};
 
+#if !VUI_COMPACT_VERTEX
+
+//
+// the fragment shader branch for the glyphs of an SDF glyph texture, see vui_stbtt_glyph_texture_set_sdf.
+// their u has 2.0 added to it before VUI negates the texture coordinates of alpha masks, so it is below -1.5.
+// the distance is 0.5 on the outline, and the edge is blended over the width of a pixel on screen.
+#define _vui_opengl_sdf_glyph_branch_src \
+	"  } else if (f_uv.x < -1.5) {\n" \
+	"	float dist = texture(u_texture, vec2(-f_uv.x - 2.0, -f_uv.y)).r;\n" \
+	"	float aa_width = 0.7 * length(vec2(dFdx(dist), dFdy(dist)));\n" \
+	"	out_color = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - aa_width, 0.5 + aa_width, dist)) * f_color;\n"
+
+#endif // !VUI_COMPACT_VERTEX
+
+#if VUI_SDF_SHAPES
+
+const char* vui_opengl_sdf_vertex_shader_src =
+	"#version 330 core\n"
+	"layout(location = 0) in vec2 v_pos;\n"
+	"layout(location = 1) in vec2 v_uv;\n"
+	"layout(location = 2) in vec4 v_color;\n"
+	"layout(location = 3) in vec2 v_sdf_center;\n"
+	"layout(location = 4) in vec2 v_sdf_half_size;\n"
+	"layout(location = 5) in vec2 v_sdf_radius_border_width;\n"
+	"smooth out vec2 f_pos;\n"
+	"smooth out vec2 f_uv;\n"
+	"smooth out vec4 f_color;\n"
+	"flat out vec2 f_sdf_center;\n"
+	"flat out vec2 f_sdf_half_size;\n"
+	"flat out vec2 f_sdf_radius_border_width;\n"
+	"uniform mat4 u_mvp;\n"
+	"void main() {\n"
+	"  gl_Position = u_mvp * vec4(v_pos, 0.0, 1.0);\n"
+	"  f_pos = v_pos;\n"
+	"  f_uv = v_uv;\n"
+	"  f_color = v_color;\n"
+	"  f_sdf_center = v_sdf_center;\n"
+	"  f_sdf_half_size = v_sdf_half_size;\n"
+	"  f_sdf_radius_border_width = v_sdf_radius_border_width;\n"
+	"}";
+
+const char* vui_opengl_sdf_fragment_shader_src =
+	"#version 330 core\n"
+	"smooth in vec2 f_pos;\n"
+	"smooth in vec2 f_uv;\n"
+	"smooth in vec4 f_color;\n"
+	"flat in vec2 f_sdf_center;\n"
+	"flat in vec2 f_sdf_half_size;\n"
+	"flat in vec2 f_sdf_radius_border_width;\n"
+	"out vec4 out_color;\n"
+	"uniform sampler2D u_texture;\n"
+	"void main() {\n"
+	"  if (f_sdf_half_size.x > 0.0) {\n"
+	"	float radius = f_sdf_radius_border_width.x;\n"
+	"	float border_width = f_sdf_radius_border_width.y;\n"
+	"	vec2 q = abs(f_pos - f_sdf_center) - f_sdf_half_size + radius;\n"
+	"	float dist = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;\n"
+	"	float alpha = clamp(0.5 - dist, 0.0, 1.0);\n"
+	"	if (border_width > 0.0) {\n"
+	"	  alpha *= clamp(0.5 + dist + border_width, 0.0, 1.0);\n"
+	"	}\n"
+	"	out_color = vec4(f_color.rgb, f_color.a * alpha);\n"
+	"  } else if (f_uv == vec2(0.0)) {\n"
+	"	out_color = f_color;\n"
+	_vui_opengl_sdf_glyph_branch_src
+	"  } else if (f_uv.x < 0.0) {\n"
+	"	out_color = vec4(1.0, 1.0, 1.0, texture(u_texture, -f_uv).r) * f_color;\n"
+	"  } else {\n"
+	"	out_color = texture(u_texture, f_uv) * f_color;\n"
+	"  }\n"
+	"}";
+
+void vui_opengl_setup_sdf_vertex_attribs() {
+	glEnableVertexAttribArray(3);
+	glEnableVertexAttribArray(4);
+	glEnableVertexAttribArray(5);
+
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, sdf_center));
+	glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, sdf_half_size));
+	glVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, sdf_radius));
+}
+
+#elif !VUI_COMPACT_VERTEX
+
+const char* vui_opengl_sdf_glyph_fragment_shader_src =
+	"#version 330 core\n"
+	"smooth in vec2 f_uv;\n"
+	"smooth in vec4 f_color;\n"
+	"out vec4 out_color;\n"
+	"uniform sampler2D u_texture;\n"
+	"void main() {\n"
+	"  if (f_uv == vec2(0.0)) {\n"
+	"	out_color = f_color;\n"
+	_vui_opengl_sdf_glyph_branch_src
+	"  } else if (f_uv.x < 0.0) {\n"
+	"	out_color = vec4(1.0, 1.0, 1.0, texture(u_texture, -f_uv).r) * f_color;\n"
+	"  } else {\n"
+	"	out_color = texture(u_texture, f_uv) * f_color;\n"
+	"  }\n"
+	"}";
+
+#endif // VUI_SDF_SHAPES
+
+#if VUI_COMPACT_VERTEX
+
+#define _vui_opengl_stringify_(x) #x
+#define _vui_opengl_stringify(x) _vui_opengl_stringify_(x)
+
+const char* vui_opengl_compact_vertex_shader_src =
+	"#version 330 core\n"
+	"layout(location = 0) in vec2 v_pos;\n"
+	"layout(location = 1) in vec2 v_uv;\n"
+	"layout(location = 2) in vec4 v_color;\n"
+	"smooth out vec2 f_uv;\n"
+	"smooth out vec4 f_color;\n"
+	"flat out float f_is_glyph;\n"
+	"uniform mat4 u_mvp;\n"
+	"void main() {\n"
+	"  gl_Position = u_mvp * vec4(v_pos * exp2(-float(" _vui_opengl_stringify(vui_compact_vertex_pos_frac_bits) ")), 0.0, 1.0);\n"
+	"  f_is_glyph = mod(v_uv.x, 2.0);\n"
+	"  f_uv = vec2(floor(v_uv.x * 0.5) / 32767.0, v_uv.y / 65535.0);\n"
+	"  f_color = v_color;\n"
+	"}";
+
+const char* vui_opengl_compact_fragment_shader_src =
+	"#version 330 core\n"
+	"smooth in vec2 f_uv;\n"
+	"smooth in vec4 f_color;\n"
+	"flat in float f_is_glyph;\n"
+	"out vec4 out_color;\n"
+	"uniform sampler2D u_texture;\n"
+	"void main() {\n"
+	"  if (f_is_glyph > 0.5) {\n"
+	"	out_color = vec4(1.0, 1.0, 1.0, texture(u_texture, f_uv).r) * f_color;\n"
+	"  } else if (f_uv == vec2(0.0)) {\n"
+	"	out_color = f_color;\n"
+	"  } else {\n"
+	"	out_color = texture(u_texture, f_uv) * f_color;\n"
+	"  }\n"
+	"}";
+
+void vui_opengl_setup_compact_vertex_attribs() {
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+
+	//
+	// the pos and uv are not normalized, the vertex shader decodes them.
+	glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, pos));
+	glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, uv));
+	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, color));
+}
+
+#endif // VUI_COMPACT_VERTEX
+
 void vui_opengl_init() {
 	glGenVertexArrays(1, &_vui_opengl_state.vao);
 	glBindVertexArray(_vui_opengl_state.vao);
@@ -46,14 +201,28 @@ void vui_opengl_render(VuiWindowRender* w) {
 		case sizeof(uint32_t): index_type = GL_UNSIGNED_INT; break;
 	}
 
+	//
+	// the clip rectangles are top down, but OpenGL's window coordinates are bottom up.
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glEnable(GL_SCISSOR_TEST);
+
 	VuiRenderCmd* cmds = w->cmds;
 	for (int i = 0; i < VuiStk_count(w->cmds); i += 1) {
 		VuiRenderCmd* c = &cmds[i];
+		GLint left = viewport[0] + (GLint)floorf(c->clip_rect.left);
+		GLint bottom = viewport[1] + viewport[3] - (GLint)ceilf(c->clip_rect.bottom);
+		GLsizei width = (GLsizei)(ceilf(c->clip_rect.right) - floorf(c->clip_rect.left));
+		GLsizei height = (GLsizei)(ceilf(c->clip_rect.bottom) - floorf(c->clip_rect.top));
+		if (width <= 0 || height <= 0) continue;
+		glScissor(left, bottom, width, height);
+
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, c->texture_id);
-		glDrawElements(GL_TRIANGLES, c->indices_count, index_type, (void*)((uintptr_t)c->indices_start_idx * sizeof(VuiVertexIdx)));
+		glDrawElementsBaseVertex(GL_TRIANGLES, c->indices_count, index_type, (void*)((uintptr_t)c->indices_start_idx * sizeof(VuiVertexIdx)), c->verts_base_idx);
 	}
 
+	glDisable(GL_SCISSOR_TEST);
 	glBindVertexArray(0);
 }
 
@@ -10,3 +10,33 @@ void vui_opengl_init();
 // WARNING: be sure to bind the correct shader and perform all the calls to glVertexAttribPointer that setup the shader attributes.
 void vui_opengl_render(VuiWindowRender* w);
 
+#if VUI_SDF_SHAPES
+//
+// reference shaders for when VUI_SDF_SHAPES is enabled with the default VuiVertex.
+// the fragment shader also draws the glyphs of SDF glyph textures, see vui_stbtt_glyph_texture_set_sdf.
+// the attribute locations 0, 1 & 2 are the pos, uv & color like usual.
+// the SDF attributes are in locations 3, 4 & 5, call vui_opengl_setup_sdf_vertex_attribs to set them up.
+// the fragment shader expects the projection to map VuiVertex.pos onto pixels (eg. with u_mvp),
+// since the anti-aliasing is one pixel wide.
+extern const char* vui_opengl_sdf_vertex_shader_src;
+extern const char* vui_opengl_sdf_fragment_shader_src;
+void vui_opengl_setup_sdf_vertex_attribs();
+#endif
+
+#if !VUI_SDF_SHAPES && !VUI_COMPACT_VERTEX
+//
+// a reference fragment shader for the default VuiVertex that draws the glyphs of SDF glyph textures,
+// see vui_stbtt_glyph_texture_set_sdf in backends/vui_stbtruetype_manager.h. everything else is drawn like usual.
+// it expects the vertex shader to output the f_uv & f_color of the vertex, like the one in examples/ctrl_gallery.c.
+extern const char* vui_opengl_sdf_glyph_fragment_shader_src;
+#endif
+
+#if VUI_COMPACT_VERTEX
+//
+// reference shaders for when VUI_COMPACT_VERTEX is enabled with the default VuiVertex.
+// the attribute locations 0, 1 & 2 are the pos, uv & color like usual, but they are integers
+// that the vertex shader decodes. so call vui_opengl_setup_compact_vertex_attribs to set them up.
+extern const char* vui_opengl_compact_vertex_shader_src;
+extern const char* vui_opengl_compact_fragment_shader_src;
+void vui_opengl_setup_compact_vertex_attribs();
+#endif
@@ -10,14 +10,11 @@ VuiPositionTextRet vui_stbtt_position_text(VuiPositionTextArgs* args) {
 	if (args->text_length == 0) { return (VuiPositionTextRet){ .vec2 = VuiVec2_zero }; }
 
 	//
-	// get the font info, vertical metrics and the scale for the line height.
+	// get the vertical metrics and the scale for the line height.
 	//
 
-	stbtt_fontinfo* info = vui_stbtt_get_info(args->font_id);
 	int ascent, descent, line_gap;
-	stbtt_GetFontVMetrics(info, &ascent, &descent, &line_gap);
-
-	float scale = stbtt_ScaleForPixelHeight(info, args->line_height);
+	float scale = vui_stbtt_get_v_metrics(args->font_id, args->line_height, &ascent, &descent, &line_gap);
 	ascent = roundf(ascent * scale);
 	descent = roundf(descent * scale);
 
@@ -72,7 +69,7 @@ VuiPositionTextRet vui_stbtt_position_text(VuiPositionTextArgs* args) {
 		}
 
 		i += vui_utf8_codepoint(&args->text[i], &codept);
-		codept_glyph = stbtt_FindGlyphIndex(info, codept);
+		codept_glyph = vui_stbtt_find_glyph_idx(args->font_id, codept);
 		if (is_scanning_word_for_wrapping) {
 			word_start_codept = codept;
 			word_start_glyph = codept_glyph;
@@ -84,7 +81,7 @@ VuiPositionTextRet vui_stbtt_position_text(VuiPositionTextArgs* args) {
 		while (1) {
 			int advance_width;
 			int left_side_bearing;
-			stbtt_GetGlyphHMetrics(info, codept_glyph, &advance_width, &left_side_bearing);
+			vui_stbtt_get_glyph_h_metrics(args->font_id, codept_glyph, &advance_width, &left_side_bearing);
 			float advance_width_f = advance_width * scale;
 
 			if (!is_scanning_word_for_wrapping) {
@@ -139,13 +136,13 @@ RETURN_CURSOR_IDX_GO_BACK:
 					// substitute the rest of the control characters as spaces.
 					int advance_width;
 					int left_side_bearing;
-					codept_glyph = stbtt_FindGlyphIndex(info, ' ');
-					stbtt_GetGlyphHMetrics(info, codept_glyph, &advance_width, &left_side_bearing);
+					codept_glyph = vui_stbtt_find_glyph_idx(args->font_id, ' ');
+					vui_stbtt_get_glyph_h_metrics(args->font_id, codept_glyph, &advance_width, &left_side_bearing);
 					pos.x += advance_width * scale;
 				}
 
 				i += vui_utf8_codepoint(&args->text[i], &codept);
-				codept_glyph = stbtt_FindGlyphIndex(info, codept);
+				codept_glyph = vui_stbtt_find_glyph_idx(args->font_id, codept);
 
 				//
 				// treat the control characters as a delimiter and continue to the next character.
@@ -231,10 +228,10 @@ RETURN_CURSOR_IDX_GO_BACK:
 				break;
 			}
 
-			int next_codept_glyph = stbtt_FindGlyphIndex(info, next_codept);
+			int next_codept_glyph = vui_stbtt_find_glyph_idx(args->font_id, next_codept);
 
 			int kern;
-			kern = stbtt_GetGlyphKernAdvance(info, codept_glyph, next_codept_glyph);
+			kern = vui_stbtt_get_glyph_kern_advance(args->font_id, codept_glyph, next_codept_glyph);
 			pos.x += roundf(kern * scale);
 
 			//
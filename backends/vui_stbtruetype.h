@@ -21,6 +21,17 @@
 // gets the stbtt_fontinfo for the font with the font_id
 stbtt_fontinfo* vui_stbtt_get_info(VuiFontId font_id);
 
+//
+// these are called for every codepoint when text is positioned, so you may want to cache them.
+// otherwise they can just call the stbtt function of the same name with the stbtt_fontinfo of the font.
+//
+// vui_stbtt_get_v_metrics gets the unscaled vertical metrics like stbtt_GetFontVMetrics
+// and returns the scale for the line height like stbtt_ScaleForPixelHeight.
+float vui_stbtt_get_v_metrics(VuiFontId font_id, float line_height, int* ascent_out, int* descent_out, int* line_gap_out);
+int vui_stbtt_find_glyph_idx(VuiFontId font_id, int32_t codept);
+void vui_stbtt_get_glyph_h_metrics(VuiFontId font_id, int stb_glyph_idx, int* advance_width_out, int* left_side_bearing_out);
+int vui_stbtt_get_glyph_kern_advance(VuiFontId font_id, int stb_glyph_idx_a, int stb_glyph_idx_b);
+
 //
 // this is called to render a glyph with a certain font and line height.
 // you will need to call render_glyph_fn(rect, texture_id, uv_rect) internally.
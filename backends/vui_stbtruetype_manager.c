@@ -7,6 +7,11 @@
 #include "stb_truetype.h"
 #endif
 
+#ifndef vui_stbtt_no_pthread
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #ifndef vui_stbtt_glyph_texture_default_width_and_height
 #define vui_stbtt_glyph_texture_default_width_and_height 512
 #endif
@@ -23,6 +28,59 @@
 #define vui_stbtt_glyph_texture_default_oversample_y 1
 #endif
 
+//
+// in the incremental mode, a glyph that has not been found while measuring text or rendered for this many packs
+// can be evicted the next time the whole texture is packed.
+#ifndef vui_stbtt_glyph_texture_evict_after_packs
+#define vui_stbtt_glyph_texture_evict_after_packs 120
+#endif
+
+//
+// in the incremental mode, the whole texture is packed again once the space of evicted glyphs
+// that has not been given to new glyphs goes over this fraction of the texture.
+#ifndef vui_stbtt_glyph_texture_compact_threshold
+#define vui_stbtt_glyph_texture_compact_threshold 0.25f
+#endif
+
+//
+// the glyph index of every codepoint below this is looked up when the font is added and kept in a dense array.
+// the default covers Basic Latin up to the end of Latin Extended-B, the rest go in a hash table as they are found.
+#ifndef vui_stbtt_font_dense_codepts_count
+#define vui_stbtt_font_dense_codepts_count 0x250
+#endif
+
+//
+// the most entries the codepoint and kerning hash tables of a font can hold, when one is full it is cleared.
+#ifndef vui_stbtt_font_cache_cap
+#define vui_stbtt_font_cache_cap 65536
+#endif
+
+//
+// in the SDF mode, every glyph is rendered once at this line height and its quad is scaled to the line height of the text.
+#ifndef vui_stbtt_sdf_line_height
+#define vui_stbtt_sdf_line_height 32.f
+#endif
+
+//
+// in the SDF mode, how many pixels (at vui_stbtt_sdf_line_height) the distance field goes out past the outline of a glyph.
+// the distance falls from the middle value on the outline to zero at the end of the padding.
+#ifndef vui_stbtt_sdf_padding
+#define vui_stbtt_sdf_padding 4
+#endif
+
+//
+// vui_stbtt_parallel_for_pthread uses at most this many threads, including the calling thread.
+#ifndef vui_stbtt_pthread_threads_cap
+#define vui_stbtt_pthread_threads_cap 16
+#endif
+
+//
+// vui_stbtt_parallel_for_pthread only starts another thread for every this many jobs,
+// so packs that only render a few new glyphs do not pay for starting threads.
+#ifndef vui_stbtt_pthread_min_jobs_per_thread
+#define vui_stbtt_pthread_min_jobs_per_thread 32
+#endif
+
 // ==========================================================
 //
 //
@@ -41,9 +99,38 @@
 #define _VuiGlyphTextureId_counter_MASK 0xfff00000
 #define _VuiGlyphTextureId_counter_SHIFT 20
 
+typedef struct _VuiStbttGlyphHMetrics _VuiStbttGlyphHMetrics;
+struct _VuiStbttGlyphHMetrics {
+	uint16_t advance_width;
+	int16_t left_side_bearing;
+};
+
+//
+// an entry of the open addressing hash tables in the font cache. a key of zero is an empty slot.
+typedef struct _VuiStbttCacheSlot _VuiStbttCacheSlot;
+struct _VuiStbttCacheSlot {
+	uint32_t key;
+	int32_t value;
+};
+
 typedef struct _VuiStbttInfo _VuiStbttInfo;
 struct _VuiStbttInfo {
 	stbtt_fontinfo inner;
+
+	//
+	// stbtt parses the font tables on every lookup, so the results are cached here.
+	// the vertical metrics and the dense arrays are filled when the font is added,
+	// the hash tables are filled as codepoints and glyph pairs are found.
+	int ascent;
+	int descent;
+	int line_gap;
+	uint16_t dense_glyph_idxs[vui_stbtt_font_dense_codepts_count];
+	VuiStk(_VuiStbttGlyphHMetrics) glyph_h_metrics;
+	VuiStk(_VuiStbttCacheSlot) codept_glyph_idx_slots;
+	VuiStk(_VuiStbttCacheSlot) kern_slots;
+	uint32_t codept_glyph_idxs_count;
+	uint32_t kerns_count;
+
 	uint16_t counter;
 };
 
@@ -61,6 +148,8 @@ struct _VuiStbttStyledGlyph {
 	float line_height;
 	int stb_glyph_idx;
 	uint32_t tex_height;
+	uint32_t last_used_pack_idx;
+	VuiBool is_being_evicted;
 };
 
 typedef struct _VuiStbttStyledGlyphRect _VuiStbttStyledGlyphRect;
@@ -70,13 +159,51 @@ struct _VuiStbttStyledGlyphRect {
 	_VuiStbttRect tex;
 };
 
+typedef struct _VuiStbttImage _VuiStbttImage;
+struct _VuiStbttImage {
+	VuiImageId image_id;
+	VuiStk(uint8_t) pixels;
+	uint32_t width;
+	uint32_t height;
+	//
+	// where the image was placed in the texture by the last pack, without the margin.
+	_VuiStbttRect tex;
+};
+
 typedef struct _VuiStbttGlyphTexture _VuiStbttGlyphTexture;
 struct _VuiStbttGlyphTexture {
 	VuiStk(uint8_t) pixels;
 	VuiStk(_VuiStbttStyledGlyph) styled_glyphs;
 	VuiStk(_VuiStbttStyledGlyphRect) styled_glyph_rects;
+	//
+	// an open addressing hash table that maps a styled glyph to its index in styled_glyphs + 1, zero is an empty slot.
+	// the slots count is always a power of two and at least double the styled glyphs count.
+	VuiStk(uint32_t) styled_glyph_slots;
+	VuiStk(_VuiStbttImage) images;
 	VuiStk(_VuiStbttRect) empty_rects;
 	uint32_t width_and_height;
+
+	//
+	// the styled glyphs that have a rect have been rendered in to the texture, in the incremental mode
+	// the ones that have been added since are placed in the empty rects on the next pack.
+	// evicted_area is how much of the texture evicted glyphs have given back since everything was last packed.
+	VuiBool is_incremental;
+	VuiBool is_full_pack_needed;
+
+	//
+	// in the SDF mode the styled glyphs all have a line_height of vui_stbtt_sdf_line_height.
+	VuiBool is_sdf;
+	uint32_t packs_count;
+	uint32_t generation;
+	uint64_t evicted_area;
+
+	//
+	// the rects of the texture that the last pack wrote pixels to, so only they need to be sent to the GPU.
+	// is_resized is set when the texture is not the same size it was after the pack before.
+	VuiStk(_VuiStbttRect) dirty_rects;
+	uint32_t packed_width_and_height;
+	VuiBool is_resized;
+
 	VuiTextureId texture_id;
 	uint32_t margin;
 	uint8_t oversample_x;
@@ -107,21 +234,122 @@ static _VuiStbttGlyphTexture* _vui_stbtt_glyph_texture_get(VuiGlyphTextureId gly
 	return tex;
 }
 
-static uint32_t _vui_stbtt_find_styled_glyph_id(_VuiStbttGlyphTexture* tex, VuiFontId font_id, float line_height, int stb_glyph_idx) {
+static _VuiStbttInfo* _vui_stbtt_font_get(VuiFontId font_id) {
+	vui_assert(font_id, "cannot get an font with a NULL identifier");
+
 	//
-	// see if the glyph already exists in the glyph texture
-	_VuiStbttStyledGlyph* styled_glyphs = tex->styled_glyphs;
-	uint32_t count = VuiStk_count(styled_glyphs);
-	uint32_t glyph_id = 0;
-	for (uint32_t i = 0; i < count; i += 1) {
-		_VuiStbttStyledGlyph* glyph = &styled_glyphs[i];
+	// get the counter and ensure that it matches the one stored in the font_id
+	VuiPoolId pool_id = (font_id & _VuiFontId_pool_id_MASK) >> _VuiFontId_pool_id_SHIFT;
+	uint16_t counter = (font_id & _VuiFontId_counter_MASK) >> _VuiFontId_counter_SHIFT;
+	_VuiStbttInfo* info = _VuiPool_id_to_ptr((_VuiPool*)&_vui_stbtt.font_pool, pool_id, sizeof(_VuiStbttInfo));
+	vui_assert(info->counter == counter, "trying to get a font with an old identifier");
+
+	return info;
+}
+
+static uint32_t _vui_stbtt_cache_find_slot(_VuiStbttCacheSlot* slots, uint32_t key) {
+	//
+	// the slots count is always a power of two, so the hash can be masked in to range.
+	uint32_t mask = VuiStk_count(slots) - 1;
+	uint32_t slot_idx = (uint32_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	while (slots[slot_idx].key && slots[slot_idx].key != key) {
+		slot_idx = (slot_idx + 1) & mask;
+	}
+	return slot_idx;
+}
+
+static VuiBool _vui_stbtt_cache_lookup(_VuiStbttCacheSlot* slots, uint32_t key, int32_t* value_out) {
+	if (VuiStk_count(slots) == 0) return vui_false;
+	_VuiStbttCacheSlot* slot = &slots[_vui_stbtt_cache_find_slot(slots, key)];
+	if (slot->key == 0) return vui_false;
+	*value_out = slot->value;
+	return vui_true;
+}
+
+static void _vui_stbtt_cache_insert(VuiStk(_VuiStbttCacheSlot)* slots_ptr, uint32_t* count_ptr, uint32_t key, int32_t value) {
+	_VuiStbttCacheSlot* slots = *slots_ptr;
+	uint32_t slots_count = VuiStk_count(slots);
+	if (*count_ptr == vui_stbtt_font_cache_cap) {
+		//
+		// the table is holding as much as it is allowed to, so start again.
+		memset(slots, 0, slots_count * sizeof(*slots));
+		*count_ptr = 0;
+	} else if ((*count_ptr + 1) * 2 > slots_count) {
+		//
+		// never let the table be more than half full, so the probing stays short.
+		// grow by rehashing in to a table twice the size.
+		uint32_t new_slots_count = slots_count ? slots_count * 2 : 64;
+		_VuiStbttCacheSlot* new_slots = NULL;
+		if (!VuiStk_push_many(&new_slots, new_slots_count)) return;
+		memset(new_slots, 0, new_slots_count * sizeof(*new_slots));
+		for (uint32_t slot_idx = 0; slot_idx < slots_count; slot_idx += 1) {
+			if (slots[slot_idx].key) {
+				new_slots[_vui_stbtt_cache_find_slot(new_slots, slots[slot_idx].key)] = slots[slot_idx];
+			}
+		}
+
+		VuiStk_deinit(slots);
+		slots = new_slots;
+		*slots_ptr = new_slots;
+	}
+
+	_VuiStbttCacheSlot* slot = &slots[_vui_stbtt_cache_find_slot(slots, key)];
+	if (slot->key == 0) *count_ptr += 1;
+	slot->key = key;
+	slot->value = value;
+}
+
+static uint32_t _vui_stbtt_styled_glyph_find_slot(_VuiStbttGlyphTexture* tex, VuiFontId font_id, float line_height, int stb_glyph_idx) {
+	uint32_t line_height_bits;
+	memcpy(&line_height_bits, &line_height, sizeof(line_height_bits));
+	uint64_t hash = ((uint64_t)font_id << 32) | line_height_bits;
+	hash ^= (uint64_t)(uint32_t)stb_glyph_idx * 0x9E3779B97F4A7C15ull;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 32;
+
+	uint32_t* slots = tex->styled_glyph_slots;
+	uint32_t mask = VuiStk_count(slots) - 1;
+	uint32_t slot_idx = (uint32_t)hash & mask;
+	while (slots[slot_idx]) {
+		_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[slots[slot_idx] - 1];
 		if (glyph->stb_glyph_idx == stb_glyph_idx && glyph->line_height == line_height && glyph->font_id == font_id) {
-			glyph_id = i + 1;
 			break;
 		}
+		slot_idx = (slot_idx + 1) & mask;
 	}
 
-	return glyph_id;
+	return slot_idx;
+}
+
+//
+// reinserts all of the styled glyphs in to a hash table with slots_count slots.
+// this is called when the table is too full and when the styled glyphs are reordered.
+static VuiBool _vui_stbtt_styled_glyph_slots_rebuild(_VuiStbttGlyphTexture* tex, uint32_t slots_count) {
+	if (slots_count == 0) return vui_true;
+	VuiStk_clear(tex->styled_glyph_slots);
+	uint32_t* slots = VuiStk_push_many(&tex->styled_glyph_slots, slots_count);
+	if (!slots) return vui_false;
+	memset(slots, 0, slots_count * sizeof(*slots));
+
+	for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
+		_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[glyph_i];
+		slots[_vui_stbtt_styled_glyph_find_slot(tex, glyph->font_id, glyph->line_height, glyph->stb_glyph_idx)] = glyph_i + 1;
+	}
+
+	return vui_true;
+}
+
+//
+// in the SDF mode a glyph is only rendered at vui_stbtt_sdf_line_height, so every line height shares it.
+static float _vui_stbtt_glyph_texture_line_height(_VuiStbttGlyphTexture* tex, float line_height) {
+	return tex->is_sdf ? vui_stbtt_sdf_line_height : line_height;
+}
+
+static uint32_t _vui_stbtt_find_styled_glyph_id(_VuiStbttGlyphTexture* tex, VuiFontId font_id, float line_height, int stb_glyph_idx) {
+	//
+	// see if the glyph already exists in the glyph texture
+	if (VuiStk_count(tex->styled_glyph_slots) == 0) return 0;
+	return tex->styled_glyph_slots[_vui_stbtt_styled_glyph_find_slot(tex, font_id, line_height, stb_glyph_idx)];
 }
 
 static VuiBool _vui_stbtt_glyph_texture_add_empty_rect(_VuiStbttGlyphTexture* tex, _VuiStbttRect* rect) {
@@ -151,6 +379,91 @@ static VuiBool _vui_stbtt_glyph_texture_add_empty_rect(_VuiStbttGlyphTexture* te
 	return vui_true;
 }
 
+//
+// gives the rectangle a place in the texture, the width and height of the rectangle must include the margin on entry.
+// on return the rectangle is where the inside of the margin is, so the margin is removed from the width and height.
+// if there is no space left, the texture is doubled in size when can_grow is set, otherwise vui_false is returned.
+static VuiBool _vui_stbtt_glyph_texture_place_rect(VuiGlyphTextureId glyph_texture_id, _VuiStbttGlyphTexture* tex, _VuiStbttRect* rect, VuiBool can_grow) {
+	uint32_t rect_i;
+	while (1) {
+		//
+		// the array is stored in small to large order, so the first empty rectangle that fits our rectangle is about the smallest one that does.
+		// this keeps the large empty rectangles whole for the glyphs that need them,
+		// instead of slicing a strip off of the largest one for every glyph.
+		uint32_t empty_rects_count = VuiStk_count(tex->empty_rects);
+		for (rect_i = 0; rect_i < empty_rects_count; rect_i += 1) {
+			_VuiStbttRect* r = &tex->empty_rects[rect_i];
+			if (r->w >= rect->w && r->h >= rect->h) break;
+		}
+
+		if (rect_i != empty_rects_count) break;
+		if (!can_grow) return vui_false;
+
+		//
+		// we are out of space so double the glyph texture and try again.
+		uint32_t old_wh = tex->width_and_height;
+		uint32_t wh = old_wh * 2;
+		if (!vui_stbtt_glyph_texture_resize(glyph_texture_id, wh))
+			return vui_false;
+
+		//
+		// the new empty rectangle to the right of where the texture used to end.
+		// this does not fill the height out to the new size.
+		// it just creates an empty rectangle the size of the old texture.
+		_VuiStbttRect empty_rect_right = { old_wh, 0, old_wh, old_wh };
+		if (!_vui_stbtt_glyph_texture_add_empty_rect(tex, &empty_rect_right))
+			return vui_false;
+
+		//
+		// the new empty rectangle to the bottom of the old texture, that fills the whole new width.
+		_VuiStbttRect empty_rect_bottom = { 0, old_wh, wh, old_wh };
+		if (!_vui_stbtt_glyph_texture_add_empty_rect(tex, &empty_rect_bottom))
+			return vui_false;
+	}
+
+	//
+	// get the rectangle that fit our rectangle from the stack.
+	_VuiStbttRect empty_r = tex->empty_rects[rect_i];
+	VuiStk_remove_shift(tex->empty_rects, rect_i);
+
+	//
+	// give the rectangle the top left hand side of the empty rectangle.
+	rect->x = empty_r.x + tex->margin;
+	rect->y = empty_r.y + tex->margin;
+
+	//
+	// if the rectangle does not take up the whole width of this empty rectangle.
+	// then create an empty rectangle to the right, that has the same height
+	// as the rectangle and consumes the rest of the width.
+	if (rect->w != empty_r.w) {
+		_VuiStbttRect split_right_rect = {
+			empty_r.x + rect->w, empty_r.y,
+			empty_r.w - rect->w, rect->h
+		};
+
+		_vui_stbtt_glyph_texture_add_empty_rect(tex, &split_right_rect);
+	}
+
+	//
+	// if the rectangle does not take up the whole height of this empty rectangle.
+	// then create a empty rectangle underneath the rectangle, that consumes the
+	// rest of the width and height.
+	if (rect->h != empty_r.h) {
+		_VuiStbttRect split_bottom_rect = {
+			empty_r.x, empty_r.y + rect->h,
+			empty_r.w, empty_r.h - rect->h
+		};
+
+		_vui_stbtt_glyph_texture_add_empty_rect(tex, &split_bottom_rect);
+	}
+
+	//
+	// remove the margin from the width and the height;
+	rect->w -= tex->margin * 2;
+	rect->h -= tex->margin * 2;
+	return vui_true;
+}
+
 // ==========================================================
 //
 //
@@ -161,19 +474,97 @@ static VuiBool _vui_stbtt_glyph_texture_add_empty_rect(_VuiStbttGlyphTexture* te
 
 VuiGlyphTextureId (*vui_stbtt_get_styled_glyph_texture_id)(VuiFontId font_id, float line_height, int32_t codept);
 
+#ifndef vui_stbtt_no_pthread
+void (*vui_stbtt_parallel_for)(uint32_t count, void (*fn)(uint32_t idx, void* ud), void* ud) = vui_stbtt_parallel_for_pthread;
+
+typedef struct _VuiStbttPthreadJob _VuiStbttPthreadJob;
+struct _VuiStbttPthreadJob {
+	void (*fn)(uint32_t idx, void* ud);
+	void* ud;
+	uint32_t count;
+	uint32_t start_idx;
+	uint32_t stride;
+	VuiBool is_started;
+	pthread_t thread;
+};
+
+//
+// each thread takes every stride'th index, the glyphs are sorted by height so this shares the work out evenly.
+static void* _vui_stbtt_pthread_job_main(void* arg) {
+	_VuiStbttPthreadJob* job = arg;
+	for (uint32_t idx = job->start_idx; idx < job->count; idx += job->stride) {
+		job->fn(idx, job->ud);
+	}
+	return NULL;
+}
+
+void vui_stbtt_parallel_for_pthread(uint32_t count, void (*fn)(uint32_t idx, void* ud), void* ud) {
+	uint32_t threads_count = count / vui_stbtt_pthread_min_jobs_per_thread;
+	long cpus_count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus_count > 0 && threads_count > (uint32_t)cpus_count) threads_count = cpus_count;
+	if (threads_count > vui_stbtt_pthread_threads_cap) threads_count = vui_stbtt_pthread_threads_cap;
+	if (threads_count < 1) threads_count = 1;
+
+	_VuiStbttPthreadJob jobs[vui_stbtt_pthread_threads_cap];
+	for (uint32_t job_i = 0; job_i < threads_count; job_i += 1) {
+		_VuiStbttPthreadJob* job = &jobs[job_i];
+		job->fn = fn;
+		job->ud = ud;
+		job->count = count;
+		job->start_idx = job_i;
+		job->stride = threads_count;
+		job->is_started = job_i > 0 && pthread_create(&job->thread, NULL, _vui_stbtt_pthread_job_main, job) == 0;
+	}
+
+	//
+	// the calling thread does the first share, and the share of any thread that could not be started.
+	for (uint32_t job_i = 0; job_i < threads_count; job_i += 1) {
+		_VuiStbttPthreadJob* job = &jobs[job_i];
+		if (job->is_started) {
+			pthread_join(job->thread, NULL);
+		} else {
+			_vui_stbtt_pthread_job_main(job);
+		}
+	}
+}
+#else
+void (*vui_stbtt_parallel_for)(uint32_t count, void (*fn)(uint32_t idx, void* ud), void* ud);
+#endif
+
 VuiFontId vui_stbtt_font_add(const uint8_t* font_file_bytes) {
 	//
 	// allocate a new font from the font pool and zero the memory
 	VuiPoolId pool_id = 0;
 	_VuiStbttInfo* info = _VuiPool_alloc((_VuiPool*)&_vui_stbtt.font_pool, &pool_id, sizeof(_VuiStbttInfo), alignof(_VuiStbttInfo));
 	if (info == NULL) return 0;
-	memset(&info->inner, 0, sizeof(info->inner));
+
+	//
+	// zero the font but keep the counter the same
+	uint16_t counter = info->counter;
+	memset(info, 0, sizeof(*info));
+	info->counter = counter;
 
 	//
 	// initialize the font, return 0 on failure
 	if (stbtt_InitFont(&info->inner, font_file_bytes, 0) == 0)
 		return 0;
 
+	//
+	// fill the parts of the cache that are known up front.
+	stbtt_GetFontVMetrics(&info->inner, &info->ascent, &info->descent, &info->line_gap);
+	for (int32_t codept = 0; codept < vui_stbtt_font_dense_codepts_count; codept += 1) {
+		info->dense_glyph_idxs[codept] = stbtt_FindGlyphIndex(&info->inner, codept);
+	}
+
+	_VuiStbttGlyphHMetrics* h_metrics = VuiStk_push_many(&info->glyph_h_metrics, info->inner.numGlyphs);
+	if (info->inner.numGlyphs && !h_metrics) return 0;
+	for (int glyph_idx = 0; glyph_idx < info->inner.numGlyphs; glyph_idx += 1) {
+		int advance_width, left_side_bearing;
+		stbtt_GetGlyphHMetrics(&info->inner, glyph_idx, &advance_width, &left_side_bearing);
+		h_metrics[glyph_idx].advance_width = advance_width;
+		h_metrics[glyph_idx].left_side_bearing = left_side_bearing;
+	}
+
 	//
 	// create the font identifier by combining the pool_id and the counter
 	VuiFontId font_id = (pool_id << _VuiFontId_pool_id_SHIFT) & _VuiFontId_pool_id_MASK;
@@ -201,22 +592,19 @@ void vui_stbtt_font_remove(VuiFontId font_id) {
 		info->counter += 1;
 	}
 
+	//
+	// deallocate the cache of the font
+	info->glyph_h_metrics = VuiStk_deinit(info->glyph_h_metrics);
+	info->codept_glyph_idx_slots = VuiStk_deinit(info->codept_glyph_idx_slots);
+	info->kern_slots = VuiStk_deinit(info->kern_slots);
+
 	//
 	// now deallocate the font entry in the font pool
-	_VuiPool_dealloc((_VuiPool*)&_vui_stbtt.font_pool, pool_id, sizeof(_VuiStbttInfo), alignof(_VuiStbttInfo));
+	_VuiPool_dealloc((_VuiPool*)&_vui_stbtt.font_pool, pool_id);
 }
 
 stbtt_fontinfo* vui_stbtt_font_get(VuiFontId font_id) {
-	vui_assert(font_id, "cannot get an font with a NULL identifier");
-
-	//
-	// get the counter and ensure that it matches the one stored in the font_id
-	VuiPoolId pool_id = (font_id & _VuiFontId_pool_id_MASK) >> _VuiFontId_pool_id_SHIFT;
-	uint16_t counter = (font_id & _VuiFontId_counter_MASK) >> _VuiFontId_counter_SHIFT;
-	_VuiStbttInfo* info = _VuiPool_id_to_ptr((_VuiPool*)&_vui_stbtt.font_pool, pool_id, sizeof(_VuiStbttInfo));
-	vui_assert(info->counter == counter, "trying to remove an info with an old identifier");
-
-	return &info->inner;
+	return &_vui_stbtt_font_get(font_id)->inner;
 }
 
 VuiGlyphTextureId vui_stbtt_glyph_texture_add(VuiTextureId texture_id, uint32_t width_and_height, uint32_t margin, uint8_t oversample_x, uint8_t oversample_y) {
@@ -272,11 +660,18 @@ void vui_stbtt_glyph_texture_remove(VuiGlyphTextureId glyph_texture_id) {
 	tex->pixels = VuiStk_deinit(tex->pixels);
 	tex->styled_glyphs = VuiStk_deinit(tex->styled_glyphs);
 	tex->styled_glyph_rects = VuiStk_deinit(tex->styled_glyph_rects);
+	tex->styled_glyph_slots = VuiStk_deinit(tex->styled_glyph_slots);
 	tex->empty_rects = VuiStk_deinit(tex->empty_rects);
+	tex->dirty_rects = VuiStk_deinit(tex->dirty_rects);
+	for (uint32_t image_i = 0; image_i < VuiStk_count(tex->images); image_i += 1) {
+		VuiStk_deinit(tex->images[image_i].pixels);
+		vui_image_remove(tex->images[image_i].image_id);
+	}
+	tex->images = VuiStk_deinit(tex->images);
 
 	//
 	// now deallocate the glyph texture entry in the pool
-	_VuiPool_dealloc((_VuiPool*)&_vui_stbtt.glyph_texture_pool, pool_id, sizeof(_VuiStbttGlyphTexture), alignof(_VuiStbttGlyphTexture));
+	_VuiPool_dealloc((_VuiPool*)&_vui_stbtt.glyph_texture_pool, pool_id);
 }
 
 uint8_t* vui_stbtt_glyph_texture_get_pixels_and_wh(VuiGlyphTextureId glyph_texture_id, uint32_t* width_and_height_out) {
@@ -288,16 +683,32 @@ uint8_t* vui_stbtt_glyph_texture_get_pixels_and_wh(VuiGlyphTextureId glyph_textu
 VuiBool vui_stbtt_glyph_texture_resize(VuiGlyphTextureId glyph_texture_id, uint32_t width_and_height) {
 	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
 	tex->width_and_height = width_and_height;
+	tex->is_full_pack_needed = vui_true;
 	return VuiStk_resize_cap(&tex->pixels, (uintptr_t)width_and_height * (uintptr_t)width_and_height);
 }
 
 VuiBool vui_stbtt_glyph_texture_add_styled_glyph(VuiGlyphTextureId glyph_texture_id, VuiFontId font_id, float line_height, int stb_glyph_idx) {
 	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	line_height = _vui_stbtt_glyph_texture_line_height(tex, line_height);
 	uint32_t styled_glyph_id = _vui_stbtt_find_styled_glyph_id(tex, font_id, line_height, stb_glyph_idx);
 
 	//
 	// if it does not, then add it too the array.
-	if (styled_glyph_id == 0) {
+	if (styled_glyph_id) {
+		//
+		// the glyph is still in use, so it is kept by the incremental mode.
+		_VuiStbttStyledGlyph* g = &tex->styled_glyphs[styled_glyph_id - 1];
+		g->last_used_pack_idx = tex->packs_count;
+		g->is_being_evicted = vui_false;
+	} else {
+		//
+		// keep the hash table at most half full, it is rebuilt twice the size before it would go over.
+		uint32_t slots_count = VuiStk_count(tex->styled_glyph_slots);
+		if ((VuiStk_count(tex->styled_glyphs) + 1) * 2 > slots_count) {
+			if (!_vui_stbtt_styled_glyph_slots_rebuild(tex, slots_count ? slots_count * 2 : 256))
+				return vui_false;
+		}
+
 		//
 		// push glyphs on the end, then store the arguments
 		_VuiStbttStyledGlyph* g = VuiStk_push(&tex->styled_glyphs);
@@ -305,17 +716,25 @@ VuiBool vui_stbtt_glyph_texture_add_styled_glyph(VuiGlyphTextureId glyph_texture
 		g->font_id = font_id;
 		g->line_height = line_height;
 		g->stb_glyph_idx = stb_glyph_idx;
+		g->last_used_pack_idx = tex->packs_count;
+		g->is_being_evicted = vui_false;
+		tex->styled_glyph_slots[_vui_stbtt_styled_glyph_find_slot(tex, font_id, line_height, stb_glyph_idx)] = VuiStk_count(tex->styled_glyphs);
 
 		stbtt_fontinfo* info = vui_stbtt_font_get(font_id);
 		float scale = stbtt_ScaleForPixelHeight(info, line_height);
 
 		int offset_x, offset_y, offset_ex, offset_ey;
-		stbtt_GetGlyphBitmapBox(info, stb_glyph_idx,
-								scale * tex->oversample_x,
-								scale * tex->oversample_y,
-								&offset_x, &offset_y, &offset_ex, &offset_ey);
-
-		g->tex_height = offset_ey - offset_y + tex->oversample_y - 1;
+		if (tex->is_sdf) {
+			stbtt_GetGlyphBitmapBox(info, stb_glyph_idx, scale, scale, &offset_x, &offset_y, &offset_ex, &offset_ey);
+			g->tex_height = offset_ey != offset_y ? offset_ey - offset_y + vui_stbtt_sdf_padding * 2 : 0;
+		} else {
+			stbtt_GetGlyphBitmapBox(info, stb_glyph_idx,
+									scale * tex->oversample_x,
+									scale * tex->oversample_y,
+									&offset_x, &offset_y, &offset_ex, &offset_ey);
+
+			g->tex_height = offset_ey - offset_y + tex->oversample_y - 1;
+		}
 	}
 
 	return vui_true;
@@ -328,233 +747,587 @@ int _vui_stbtt_styled_glyph_sort_tallest_to_shortest_cmp_fn(const void * a, cons
 void vui_stbtt_glyph_texture_clear_styled_glyphs(VuiGlyphTextureId glyph_texture_id) {
 	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
 	VuiStk_clear(tex->styled_glyphs);
+	tex->is_full_pack_needed = vui_true;
+	if (tex->styled_glyph_slots) {
+		memset(tex->styled_glyph_slots, 0, VuiStk_size(tex->styled_glyph_slots));
+	}
 }
 
-VuiBool vui_stbtt_glyph_texture_pack(VuiGlyphTextureId glyph_texture_id) {
+VuiImageId vui_stbtt_glyph_texture_add_image(VuiGlyphTextureId glyph_texture_id, const uint8_t* pixels, uint32_t width, uint32_t height) {
 	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
 
+	_VuiStbttImage* image = VuiStk_push(&tex->images);
+	if (!image) return 0;
+	*image = (_VuiStbttImage){0};
+
 	//
-	// initialize the texture pixels if they haven't been already
-	if (tex->width_and_height == 0) {
-		if (!vui_stbtt_glyph_texture_resize(glyph_texture_id, vui_stbtt_glyph_texture_default_width_and_height)) {
-			return vui_false;
-		}
+	// keep a copy of the pixels, so they can be copied in to the texture every time it is packed.
+	uint8_t* dst = VuiStk_push_many(&image->pixels, (uintptr_t)width * (uintptr_t)height);
+	if (!dst) {
+		VuiStk_pop(tex->images);
+		return 0;
 	}
+	memcpy(dst, pixels, (uintptr_t)width * (uintptr_t)height);
+	image->width = width;
+	image->height = height;
 
 	//
-	// zero the texture
-	uint32_t wh = tex->width_and_height;
-	memset(tex->pixels, 0, (uintptr_t)wh * (uintptr_t)wh);
+	// the uv_rect is set when the glyph texture is packed.
+	VuiImage vui_image = {0};
+	vui_image.width = width;
+	vui_image.height = height;
+	vui_image.texture_id = tex->texture_id;
+	vui_image.is_alpha_mask = vui_true;
+	image->image_id = vui_image_add(&vui_image);
+	tex->is_full_pack_needed = vui_true;
+
+	return image->image_id;
+}
 
-	//
-	// clear the empty rectangles of the glyph texture and then store the whole glyph texture as the only empty rectangle.
-	VuiStk_clear(tex->empty_rects);
-	_VuiStbttRect* r = VuiStk_push(&tex->empty_rects);
-	if (!r) return vui_false;
-	*r = (_VuiStbttRect) { 0, 0, wh, wh };
+void vui_stbtt_glyph_texture_remove_image(VuiGlyphTextureId glyph_texture_id, VuiImageId image_id) {
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	for (uint32_t image_i = 0; image_i < VuiStk_count(tex->images); image_i += 1) {
+		_VuiStbttImage* image = &tex->images[image_i];
+		if (image->image_id == image_id) {
+			VuiStk_deinit(image->pixels);
+			VuiStk_remove_shift(tex->images, image_i);
+			vui_image_remove(image_id);
+			tex->is_full_pack_needed = vui_true;
+			return;
+		}
+	}
 
-	//
-	// sort all the styled glyphs tallest to shortest
-	qsort(tex->styled_glyphs, VuiStk_count(tex->styled_glyphs), sizeof(*tex->styled_glyphs), _vui_stbtt_styled_glyph_sort_tallest_to_shortest_cmp_fn);
-	VuiStk_clear(tex->styled_glyph_rects);
-	if (!VuiStk_resize_cap(&tex->styled_glyph_rects, VuiStk_count(tex->styled_glyphs)))
-		return vui_false;
+	vui_assert(vui_false, "image '%u' does not live in this glyph texture", image_id);
+}
+
+void vui_stbtt_glyph_texture_set_incremental(VuiGlyphTextureId glyph_texture_id, VuiBool is_incremental) {
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	tex->is_incremental = is_incremental;
+	tex->is_full_pack_needed = vui_true;
+}
+
+void vui_stbtt_glyph_texture_set_sdf(VuiGlyphTextureId glyph_texture_id, VuiBool is_sdf) {
+#if VUI_COMPACT_VERTEX
+	vui_assert(!is_sdf, "SDF glyphs have texture coordinates outside of 0 to 1, so they cannot be used with VUI_COMPACT_VERTEX");
+#endif
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	if (tex->is_sdf == is_sdf) return;
 
 	//
-	// workout the size of the rectangles for the glyphs
+	// the styled glyphs are stored by a different line height in each mode, so they all need to be found again.
+	tex->is_sdf = is_sdf;
+	vui_stbtt_glyph_texture_clear_styled_glyphs(glyph_texture_id);
+	vui_invalidate_glyphs();
+}
+
+uint32_t vui_stbtt_glyph_texture_get_generation(VuiGlyphTextureId glyph_texture_id) {
+	return _vui_stbtt_glyph_texture_get(glyph_texture_id)->generation;
+}
+
+uint32_t vui_stbtt_glyph_texture_get_dirty_rects_count(VuiGlyphTextureId glyph_texture_id, VuiBool* is_resized_out) {
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	if (is_resized_out) *is_resized_out = tex->is_resized;
+	return VuiStk_count(tex->dirty_rects);
+}
+
+void vui_stbtt_glyph_texture_get_dirty_rect(VuiGlyphTextureId glyph_texture_id, uint32_t idx, uint32_t* x_out, uint32_t* y_out, uint32_t* width_out, uint32_t* height_out) {
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+	vui_assert(idx < VuiStk_count(tex->dirty_rects), "dirty rect index '%u' is out of bounds", idx);
+
+	_VuiStbttRect* rect = &tex->dirty_rects[idx];
+	*x_out = rect->x;
+	*y_out = rect->y;
+	*width_out = rect->w;
+	*height_out = rect->h;
+}
+
+static VuiBool _vui_stbtt_glyph_texture_add_dirty_rect(_VuiStbttGlyphTexture* tex, _VuiStbttRect* rect) {
+	_VuiStbttRect* r = VuiStk_push(&tex->dirty_rects);
+	if (!r) return vui_false;
+	*r = *rect;
+	return vui_true;
+}
+
+//
+// works out the size of the rectangle for the glyph including the margin, and the offset from the baseline.
+static void _vui_stbtt_styled_glyph_rect_init(_VuiStbttGlyphTexture* tex, _VuiStbttStyledGlyph* glyph, _VuiStbttStyledGlyphRect* gr) {
+	stbtt_fontinfo* info = vui_stbtt_font_get(glyph->font_id);
 	float sub_x = stbtt__oversample_shift(tex->oversample_x);
 	float sub_y = stbtt__oversample_shift(tex->oversample_y);
 	float recip_v = 1.f / tex->oversample_x;
 	float recip_h = 1.f / tex->oversample_y;
-	for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
-		_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[glyph_i];
-		stbtt_fontinfo* info = vui_stbtt_font_get(glyph->font_id);
-
-		float scale = stbtt_ScaleForPixelHeight(info, glyph->line_height);
 
-		int offset_x, offset_y, offset_ex, offset_ey;
-		stbtt_GetGlyphBitmapBox(info, glyph->stb_glyph_idx,
-								scale * tex->oversample_x,
-								scale * tex->oversample_y,
-								&offset_x, &offset_y, &offset_ex, &offset_ey);
+	float scale = stbtt_ScaleForPixelHeight(info, glyph->line_height);
 
+	if (tex->is_sdf) {
 		//
-		// get the width and height of the glyph
-		uint32_t w = offset_ex - offset_x + tex->oversample_x - 1;
-		uint32_t h = offset_ey - offset_y + tex->oversample_y - 1;
-
-		_VuiStbttStyledGlyphRect* gr = VuiStk_push(&tex->styled_glyph_rects);
-		if (!gr) return vui_false;
+		// the distance field covers the glyph's box plus the padding on each side, the same as stbtt_GetGlyphSDF.
+		// a glyph without an outline (eg. a space) gets no pixels.
+		int x, y, ex, ey;
+		stbtt_GetGlyphBitmapBox(info, glyph->stb_glyph_idx, scale, scale, &x, &y, &ex, &ey);
+		if (x == ex || y == ey) {
+			x = y = ex = ey = 0;
+		} else {
+			x -= vui_stbtt_sdf_padding;
+			y -= vui_stbtt_sdf_padding;
+			ex += vui_stbtt_sdf_padding;
+			ey += vui_stbtt_sdf_padding;
+		}
 
 		gr->scale = scale;
+		gr->offset = VuiRect_init(x, y, ex, ey);
+		gr->tex.w = ex - x + tex->margin * 2;
+		gr->tex.h = ey - y + tex->margin * 2;
+		return;
+	}
 
-		//
-		// create the offset that can be applied to the baseline.
-		gr->offset = VuiRect_init(
-			(float)offset_x * recip_h + sub_x,
-			(float)offset_y * recip_v + sub_y,
-			(float)offset_ex * recip_h + sub_x,
-			(float)offset_ey * recip_v + sub_y
-		);
+	int offset_x, offset_y, offset_ex, offset_ey;
+	stbtt_GetGlyphBitmapBox(info, glyph->stb_glyph_idx,
+							scale * tex->oversample_x,
+							scale * tex->oversample_y,
+							&offset_x, &offset_y, &offset_ex, &offset_ey);
 
-		//
-		// add the margin to make this the outer (width and height)
-		w += tex->margin * 2;
-		h += tex->margin * 2;
+	//
+	// get the width and height of the glyph
+	uint32_t w = offset_ex - offset_x + tex->oversample_x - 1;
+	uint32_t h = offset_ey - offset_y + tex->oversample_y - 1;
 
-		gr->tex.w = w;
-		gr->tex.h = h;
-	}
+	gr->scale = scale;
 
 	//
-	// assign all the glyphs a place in the texture
-	for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
-TRY_AGAIN:{}
-		_VuiStbttStyledGlyphRect* gr = &tex->styled_glyph_rects[glyph_i];
+	// create the offset that can be applied to the baseline.
+	gr->offset = VuiRect_init(
+		(float)offset_x * recip_h + sub_x,
+		(float)offset_y * recip_v + sub_y,
+		(float)offset_ex * recip_h + sub_x,
+		(float)offset_ey * recip_v + sub_y
+	);
+
+	//
+	// add the margin to make this the outer (width and height)
+	w += tex->margin * 2;
+	h += tex->margin * 2;
 
+	gr->tex.w = w;
+	gr->tex.h = h;
+}
+
+//
+// render the glyph to its assigned location in the texture, the pixels there must be zero.
+static void _vui_stbtt_styled_glyph_rasterize(_VuiStbttGlyphTexture* tex, _VuiStbttStyledGlyph* glyph, _VuiStbttStyledGlyphRect* gr) {
+	stbtt_fontinfo* info = vui_stbtt_font_get(glyph->font_id);
+	uint32_t wh = tex->width_and_height;
+	uint8_t* pixels = tex->pixels + gr->tex.x + (uintptr_t)gr->tex.y * wh;
+	float scale = gr->scale;
+
+	if (tex->is_sdf) {
 		//
-		// iterate in reverse to find a empty rectangle that fits our glyph.
-		// since the array is stored in small to large order.
-		uint32_t rect_i = VuiStk_count(tex->empty_rects);
-		while (rect_i--) {
-			r = &tex->empty_rects[rect_i];
-			if (r->w >= gr->tex.w && r->h >= gr->tex.h) break;
+		// the distance is 128 on the outline and changes by 128 / vui_stbtt_sdf_padding for every pixel away from it.
+		int w, h, x, y;
+		uint8_t* sdf = stbtt_GetGlyphSDF(info, scale, glyph->stb_glyph_idx, vui_stbtt_sdf_padding, 128, 128.f / vui_stbtt_sdf_padding, &w, &h, &x, &y);
+		if (sdf) {
+			vui_assert((uint32_t)w == gr->tex.w && (uint32_t)h == gr->tex.h, "the SDF of a glyph is a different size to the rect it was given");
+			for (int row = 0; row < h; row += 1) {
+				memcpy(pixels + (uintptr_t)row * wh, sdf + row * w, w);
+			}
+			stbtt_FreeSDF(sdf, info->userdata);
 		}
+		return;
+	}
 
-		//
-		// check if we are out of space so we can double the glyph texture and try again.
-		if (rect_i == UINT32_MAX) {
-			uint32_t old_wh = wh;
-			wh *= 2;
-			vui_stbtt_glyph_texture_resize(glyph_texture_id, wh);
-
-			//
-			// the new empty rectangle to the right of where the texture used to end.
-			// this does not fill the height out to the new size.
-			// it just creates an empty rectangle the size of the old texture.
-			_VuiStbttRect empty_rect_right = { old_wh, 0, old_wh, old_wh };
-			if (!_vui_stbtt_glyph_texture_add_empty_rect(tex, &empty_rect_right))
-				return vui_false;
+	stbtt_MakeGlyphBitmapSubpixel(info,
+								 pixels,
+								 gr->tex.w - tex->oversample_x + 1,
+								 gr->tex.h - tex->oversample_y + 1,
+								 wh,
+								 scale * tex->oversample_x,
+								 scale * tex->oversample_y,
+								 0,
+								 0,
+								 glyph->stb_glyph_idx);
 
-			//
-			// the new empty rectangle to the bottom of the old texture, that fills the whole new width.
-			_VuiStbttRect empty_rect_bottom = { 0, old_wh, wh, old_wh };
-			if (!_vui_stbtt_glyph_texture_add_empty_rect(tex, &empty_rect_bottom))
-				return vui_false;
+	//
+	// do the oversampling on the glyph that is at its assigned location in texture
+	//
+	if (tex->oversample_x > 1)
+		stbtt__h_prefilter(pixels, gr->tex.w, gr->tex.h, wh, tex->oversample_x);
 
-			goto TRY_AGAIN;
-		}
+	if (tex->oversample_y > 1)
+		stbtt__v_prefilter(pixels, gr->tex.w, gr->tex.h, wh, tex->oversample_y);
+}
 
-		//
-		// get the rectangle that fit our glyph from the stack.
-		// shift removing shouldn't be too bad, since the large
-		// empty rectangles are stored from the back.
-		_VuiStbttRect empty_r = tex->empty_rects[rect_i];
-		VuiStk_remove_shift(tex->empty_rects, rect_i);
+typedef struct _VuiStbttRasterizeArgs _VuiStbttRasterizeArgs;
+struct _VuiStbttRasterizeArgs {
+	_VuiStbttGlyphTexture* tex;
+	uint32_t start_idx;
+};
 
-		//
-		// give the glyph the top left hand side of the empty rectangle.
-		gr->tex.x = empty_r.x + tex->margin;
-		gr->tex.y = empty_r.y + tex->margin;
+static void _vui_stbtt_styled_glyph_rasterize_job_fn(uint32_t idx, void* ud) {
+	_VuiStbttRasterizeArgs* args = ud;
+	uint32_t glyph_i = args->start_idx + idx;
+	_vui_stbtt_styled_glyph_rasterize(args->tex, &args->tex->styled_glyphs[glyph_i], &args->tex->styled_glyph_rects[glyph_i]);
+}
 
-		//
-		// if the glyph does not take up the whole width of this empty rectangle.
-		// then create an empty rectangle to the right, that has the same height
-		// as the glyph and consumes the rest of the width.
-		if (gr->tex.w != empty_r.w) {
-			_VuiStbttRect split_right_rect = {
-				empty_r.x + gr->tex.w, empty_r.y,
-				empty_r.w - gr->tex.w, gr->tex.h
-			};
+//
+// renders the styled glyphs from start_idx to the end in to the texture.
+// every glyph writes to its own rect of the pixels, so they are shared out with vui_stbtt_parallel_for when it is set.
+static void _vui_stbtt_glyph_texture_rasterize_from(_VuiStbttGlyphTexture* tex, uint32_t start_idx) {
+	uint32_t count = VuiStk_count(tex->styled_glyphs) - start_idx;
+	if (count == 0) return;
+
+	_VuiStbttRasterizeArgs args = { .tex = tex, .start_idx = start_idx };
+	if (vui_stbtt_parallel_for) {
+		vui_stbtt_parallel_for(count, _vui_stbtt_styled_glyph_rasterize_job_fn, &args);
+	} else {
+		for (uint32_t idx = 0; idx < count; idx += 1) {
+			_vui_stbtt_styled_glyph_rasterize_job_fn(idx, &args);
+		}
+	}
+}
 
-			_vui_stbtt_glyph_texture_add_empty_rect(tex, &split_right_rect);
+//
+// in the incremental mode, a glyph that has not been used for vui_stbtt_glyph_texture_evict_after_packs is marked as being evicted
+// when the whole texture is packed, see _vui_stbtt_glyph_texture_pack_all. it stays in the texture for one more frame,
+// and as the glyphs are invalidated in every context then, all of the text that is still on screen finds it again.
+// the glyphs that are still marked on the next pack are removed here and their space is zeroed and given back to the empty rects.
+// returns vui_false on allocation failure.
+static VuiBool _vui_stbtt_glyph_texture_evict(_VuiStbttGlyphTexture* tex) {
+	uint32_t glyphs_count = VuiStk_count(tex->styled_glyphs);
+	uint32_t rects_count = VuiStk_count(tex->styled_glyph_rects);
+	VuiBool ok = vui_true;
+	uint32_t keep_count = 0;
+	uint32_t keep_rects_count = 0;
+	for (uint32_t glyph_i = 0; glyph_i < glyphs_count; glyph_i += 1) {
+		_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[glyph_i];
+		if (glyph_i < rects_count && glyph->is_being_evicted) {
+			_VuiStbttStyledGlyphRect* gr = &tex->styled_glyph_rects[glyph_i];
+			for (uint32_t y = 0; y < gr->tex.h; y += 1) {
+				memset(tex->pixels + gr->tex.x + (uintptr_t)(gr->tex.y + y) * tex->width_and_height, 0, gr->tex.w);
+			}
+			if (!_vui_stbtt_glyph_texture_add_dirty_rect(tex, &gr->tex))
+				ok = vui_false;
+
+			_VuiStbttRect empty_rect = {
+				gr->tex.x - tex->margin, gr->tex.y - tex->margin,
+				gr->tex.w + tex->margin * 2, gr->tex.h + tex->margin * 2,
+			};
+			_vui_stbtt_glyph_texture_add_empty_rect(tex, &empty_rect);
+			tex->evicted_area += (uint64_t)empty_rect.w * (uint64_t)empty_rect.h;
+			continue;
 		}
 
 		//
-		// if the glyph does not take up the whole height of this empty rectangle.
-		// then create a empty rectangle underneath the glyph, that consumes the
-		// rest of the width and height.
-		if (gr->tex.h != empty_r.h) {
-			_VuiStbttRect split_bottom_rect = {
-				empty_r.x, empty_r.y + gr->tex.h,
-				empty_r.w, empty_r.h - gr->tex.h
-			};
+		// move the glyphs that are kept down over the ones that were removed.
+		tex->styled_glyphs[keep_count] = *glyph;
+		if (glyph_i < rects_count) {
+			tex->styled_glyph_rects[keep_rects_count] = tex->styled_glyph_rects[glyph_i];
+			keep_rects_count += 1;
+		}
+		keep_count += 1;
+	}
+
+	if (keep_count != glyphs_count) {
+		VuiStk_remove_range_shift(tex->styled_glyphs, keep_count, glyphs_count);
+		VuiStk_remove_range_shift(tex->styled_glyph_rects, keep_rects_count, rects_count);
+		_vui_stbtt_styled_glyph_slots_rebuild(tex, VuiStk_count(tex->styled_glyph_slots));
+		tex->generation += 1;
+	}
 
-			_vui_stbtt_glyph_texture_add_empty_rect(tex, &split_bottom_rect);
+	return ok;
+}
+
+//
+// places the glyphs that have been added since the last pack in to the empty rects and renders just them.
+// returns vui_false if they do not all fit, the texture then needs to be packed from scratch.
+static VuiBool _vui_stbtt_glyph_texture_pack_new_glyphs(VuiGlyphTextureId glyph_texture_id, _VuiStbttGlyphTexture* tex) {
+	uint32_t placed_count = VuiStk_count(tex->styled_glyph_rects);
+	uint32_t glyphs_count = VuiStk_count(tex->styled_glyphs);
+	if (placed_count == glyphs_count) return vui_true;
+
+	//
+	// sort just the new glyphs tallest to shortest, the glyphs already in the texture keep their place.
+	qsort(tex->styled_glyphs + placed_count, glyphs_count - placed_count, sizeof(*tex->styled_glyphs), _vui_stbtt_styled_glyph_sort_tallest_to_shortest_cmp_fn);
+	if (!_vui_stbtt_styled_glyph_slots_rebuild(tex, VuiStk_count(tex->styled_glyph_slots)))
+		return vui_false;
+
+	if (!VuiStk_resize_cap(&tex->styled_glyph_rects, glyphs_count))
+		return vui_false;
+
+	for (uint32_t glyph_i = placed_count; glyph_i < glyphs_count; glyph_i += 1) {
+		_VuiStbttStyledGlyphRect* gr = VuiStk_push(&tex->styled_glyph_rects);
+		_vui_stbtt_styled_glyph_rect_init(tex, &tex->styled_glyphs[glyph_i], gr);
+		if (!_vui_stbtt_glyph_texture_place_rect(glyph_texture_id, tex, &gr->tex, vui_false))
+			return vui_false;
+	}
+
+	_vui_stbtt_glyph_texture_rasterize_from(tex, placed_count);
+	for (uint32_t glyph_i = placed_count; glyph_i < glyphs_count; glyph_i += 1) {
+		if (!_vui_stbtt_glyph_texture_add_dirty_rect(tex, &tex->styled_glyph_rects[glyph_i].tex))
+			return vui_false;
+	}
+
+	return vui_true;
+}
+
+static VuiBool _vui_stbtt_glyph_texture_pack_all(VuiGlyphTextureId glyph_texture_id, _VuiStbttGlyphTexture* tex) {
+	//
+	// sort all the styled glyphs tallest to shortest
+	qsort(tex->styled_glyphs, VuiStk_count(tex->styled_glyphs), sizeof(*tex->styled_glyphs), _vui_stbtt_styled_glyph_sort_tallest_to_shortest_cmp_fn);
+	if (!_vui_stbtt_styled_glyph_slots_rebuild(tex, VuiStk_count(tex->styled_glyph_slots)))
+		return vui_false;
+	VuiStk_clear(tex->styled_glyph_rects);
+	if (!VuiStk_resize_cap(&tex->styled_glyph_rects, VuiStk_count(tex->styled_glyphs)))
+		return vui_false;
+
+	//
+	// workout the size of the rectangles for the glyphs
+	for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
+		_VuiStbttStyledGlyphRect* gr = VuiStk_push(&tex->styled_glyph_rects);
+		if (!gr) return vui_false;
+		_vui_stbtt_styled_glyph_rect_init(tex, &tex->styled_glyphs[glyph_i], gr);
+	}
+
+	//
+	// in the incremental mode, make sure at least half of the texture is left empty for the glyphs that are added on later frames.
+	uint32_t wh = tex->width_and_height;
+	if (tex->is_incremental) {
+		uint64_t used_area = 0;
+		for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyph_rects); glyph_i += 1) {
+			used_area += (uint64_t)tex->styled_glyph_rects[glyph_i].tex.w * (uint64_t)tex->styled_glyph_rects[glyph_i].tex.h;
+		}
+		for (uint32_t image_i = 0; image_i < VuiStk_count(tex->images); image_i += 1) {
+			used_area += (uint64_t)(tex->images[image_i].width + tex->margin * 2) * (uint64_t)(tex->images[image_i].height + tex->margin * 2);
 		}
 
-		//
-		// remove the margin from the width and the height;
-		gr->tex.w -= tex->margin * 2;
-		gr->tex.h -= tex->margin * 2;
+		while (used_area * 2 > (uint64_t)wh * (uint64_t)wh) {
+			wh *= 2;
+		}
+		if (wh != tex->width_and_height && !vui_stbtt_glyph_texture_resize(glyph_texture_id, wh)) {
+			return vui_false;
+		}
 	}
 
 	//
-	// render the glyphs to their assigned location in the texture.
+	// clear the empty rectangles of the glyph texture and then store the whole glyph texture as the only empty rectangle.
+	VuiStk_clear(tex->empty_rects);
+	_VuiStbttRect* r = VuiStk_push(&tex->empty_rects);
+	if (!r) return vui_false;
+	*r = (_VuiStbttRect) { 0, 0, wh, wh };
+
 	//
-	uint8_t* pixels = tex->pixels;
+	// assign all the images a place in the texture, they go first as they are usually bigger than the glyphs.
+	for (uint32_t image_i = 0; image_i < VuiStk_count(tex->images); image_i += 1) {
+		_VuiStbttImage* image = &tex->images[image_i];
+		_VuiStbttRect rect = { 0, 0, image->width + tex->margin * 2, image->height + tex->margin * 2 };
+		if (!_vui_stbtt_glyph_texture_place_rect(glyph_texture_id, tex, &rect, vui_true))
+			return vui_false;
+		image->tex = rect;
+	}
+
+	//
+	// assign all the glyphs a place in the texture
 	for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
-		_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[glyph_i];
 		_VuiStbttStyledGlyphRect* gr = &tex->styled_glyph_rects[glyph_i];
-		stbtt_fontinfo* info = vui_stbtt_font_get(glyph->font_id);
-		float scale = gr->scale;
+		if (!_vui_stbtt_glyph_texture_place_rect(glyph_texture_id, tex, &gr->tex, vui_true))
+			return vui_false;
+	}
 
-		//
-		// render the glyph to its assigned location in the texture.
-		stbtt_MakeGlyphBitmapSubpixel(info,
-									 pixels + gr->tex.x + gr->tex.y * wh,
-									 gr->tex.w - tex->oversample_x + 1,
-									 gr->tex.h - tex->oversample_y + 1,
-									 wh,
-									 scale * tex->oversample_x,
-									 scale * tex->oversample_y,
-									 0,
-									 0,
-									 glyph->stb_glyph_idx);
+	//
+	// zero the texture, now that we know how big it needs to be.
+	// the whole of it is written, so it is the only dirty rect.
+	wh = tex->width_and_height;
+	memset(tex->pixels, 0, (uintptr_t)wh * (uintptr_t)wh);
+	VuiStk_clear(tex->dirty_rects);
+	if (!_vui_stbtt_glyph_texture_add_dirty_rect(tex, &(_VuiStbttRect) { 0, 0, wh, wh }))
+		return vui_false;
 
-		//
-		// do the oversampling on the glyph that is at its assigned location in texture
-		//
-		if (tex->oversample_x > 1)
-			stbtt__h_prefilter(pixels + gr->tex.x + gr->tex.y * wh, gr->tex.w, gr->tex.h, wh, tex->oversample_x);
+	//
+	// copy the images to their assigned location in the texture and tell VUI where they are.
+	float ratio = 1.f / wh;
+	for (uint32_t image_i = 0; image_i < VuiStk_count(tex->images); image_i += 1) {
+		_VuiStbttImage* image = &tex->images[image_i];
+		for (uint32_t y = 0; y < image->height; y += 1) {
+			memcpy(tex->pixels + image->tex.x + (uintptr_t)(image->tex.y + y) * wh, image->pixels + (uintptr_t)y * image->width, image->width);
+		}
+
+		VuiImage* vui_image = vui_image_get(image->image_id);
+		vui_image->uv_rect = VuiRect_init(
+			image->tex.x * ratio,
+			image->tex.y * ratio,
+			(image->tex.x + image->tex.w) * ratio,
+			(image->tex.y + image->tex.h) * ratio
+		);
+	}
+
+	//
+	// render the glyphs to their assigned location in the texture.
+	//
+	_vui_stbtt_glyph_texture_rasterize_from(tex, 0);
 
-		if (tex->oversample_y > 1)
-			stbtt__v_prefilter(pixels + gr->tex.x + gr->tex.y * wh, gr->tex.w, gr->tex.h, wh, tex->oversample_y);
+	//
+	// in the incremental mode the stale glyphs are marked now, as everything is being invalidated anyway,
+	// so they are evicted on the next pack unless they are found again.
+	// this means a UI that stops adding glyphs is never invalidated by eviction.
+	if (tex->is_incremental) {
+		for (uint32_t glyph_i = 0; glyph_i < VuiStk_count(tex->styled_glyphs); glyph_i += 1) {
+			_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[glyph_i];
+			if (tex->packs_count - glyph->last_used_pack_idx >= vui_stbtt_glyph_texture_evict_after_packs) {
+				glyph->is_being_evicted = vui_true;
+			}
+		}
 	}
 
+	//
+	// the glyphs have moved, so vertices from before cannot be reused in any context.
+	// the caches that were kept have not measured their text, so this also makes them find their glyphs again
+	// when the styled glyphs are cleared and packed every frame.
+	vui_invalidate_glyphs();
+
+	tex->evicted_area = 0;
+	tex->is_full_pack_needed = vui_false;
+	tex->generation += 1;
 	return vui_true;
 }
 
+VuiBool vui_stbtt_glyph_texture_pack(VuiGlyphTextureId glyph_texture_id) {
+	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
+
+	//
+	// initialize the texture pixels if they haven't been already
+	if (tex->width_and_height == 0) {
+		if (!vui_stbtt_glyph_texture_resize(glyph_texture_id, vui_stbtt_glyph_texture_default_width_and_height)) {
+			return vui_false;
+		}
+	}
+
+	VuiStk_clear(tex->dirty_rects);
+
+	VuiBool ok;
+	if (tex->is_incremental && !tex->is_full_pack_needed) {
+		//
+		// pack everything again if too much space is lost to holes, or the new glyphs do not fit.
+		uint64_t area = (uint64_t)tex->width_and_height * (uint64_t)tex->width_and_height;
+		ok = _vui_stbtt_glyph_texture_evict(tex) &&
+			tex->evicted_area <= area * vui_stbtt_glyph_texture_compact_threshold &&
+			_vui_stbtt_glyph_texture_pack_new_glyphs(glyph_texture_id, tex);
+		if (!ok) {
+			ok = _vui_stbtt_glyph_texture_pack_all(glyph_texture_id, tex);
+		}
+	} else {
+		ok = _vui_stbtt_glyph_texture_pack_all(glyph_texture_id, tex);
+	}
+
+	tex->is_resized = tex->width_and_height != tex->packed_width_and_height;
+	tex->packed_width_and_height = tex->width_and_height;
+	tex->packs_count += 1;
+	return ok;
+}
+
 stbtt_fontinfo* vui_stbtt_get_info(VuiFontId font_id) {
 	return vui_stbtt_font_get(font_id);
 }
 
+float vui_stbtt_get_v_metrics(VuiFontId font_id, float line_height, int* ascent_out, int* descent_out, int* line_gap_out) {
+	_VuiStbttInfo* info = _vui_stbtt_font_get(font_id);
+	*ascent_out = info->ascent;
+	*descent_out = info->descent;
+	*line_gap_out = info->line_gap;
+
+	//
+	// this is what stbtt_ScaleForPixelHeight does, without reading the font tables.
+	return line_height / (float)(info->ascent - info->descent);
+}
+
+//
+// while a window is being rendered, the caches are only read from.
+// as other windows can be rendering on other threads.
+int vui_stbtt_find_glyph_idx(VuiFontId font_id, int32_t codept) {
+	_VuiStbttInfo* info = _vui_stbtt_font_get(font_id);
+	if ((uint32_t)codept < vui_stbtt_font_dense_codepts_count) {
+		return info->dense_glyph_idxs[codept];
+	}
+
+	int32_t glyph_idx;
+	if (_vui_stbtt_cache_lookup(info->codept_glyph_idx_slots, codept, &glyph_idx)) {
+		return glyph_idx;
+	}
+
+	glyph_idx = stbtt_FindGlyphIndex(&info->inner, codept);
+	if (!vui_window_is_rendering()) {
+		_vui_stbtt_cache_insert(&info->codept_glyph_idx_slots, &info->codept_glyph_idxs_count, codept, glyph_idx);
+	}
+	return glyph_idx;
+}
+
+void vui_stbtt_get_glyph_h_metrics(VuiFontId font_id, int stb_glyph_idx, int* advance_width_out, int* left_side_bearing_out) {
+	_VuiStbttInfo* info = _vui_stbtt_font_get(font_id);
+	if ((uint32_t)stb_glyph_idx < VuiStk_count(info->glyph_h_metrics)) {
+		*advance_width_out = info->glyph_h_metrics[stb_glyph_idx].advance_width;
+		*left_side_bearing_out = info->glyph_h_metrics[stb_glyph_idx].left_side_bearing;
+	} else {
+		stbtt_GetGlyphHMetrics(&info->inner, stb_glyph_idx, advance_width_out, left_side_bearing_out);
+	}
+}
+
+int vui_stbtt_get_glyph_kern_advance(VuiFontId font_id, int stb_glyph_idx_a, int stb_glyph_idx_b) {
+	_VuiStbttInfo* info = _vui_stbtt_font_get(font_id);
+	if (!info->inner.kern && !info->inner.gpos) return 0;
+
+	//
+	// glyph indices fit in 16 bits, one is added so the key is never zero.
+	uint32_t key = (((uint32_t)stb_glyph_idx_a << 16) | ((uint32_t)stb_glyph_idx_b & 0xffff)) + 1;
+	int32_t kern;
+	if (_vui_stbtt_cache_lookup(info->kern_slots, key, &kern)) {
+		return kern;
+	}
+
+	kern = stbtt_GetGlyphKernAdvance(&info->inner, stb_glyph_idx_a, stb_glyph_idx_b);
+	if (!vui_window_is_rendering()) {
+		_vui_stbtt_cache_insert(&info->kern_slots, &info->kerns_count, key, kern);
+	}
+	return kern;
+}
+
 void vui_stbtt_render_glyph(VuiVec2 baseline_pos, VuiFontId font_id, float line_height, int32_t codept, int stb_glyph_idx, VuiBool align_to_integer, VuiRenderGlyphFn render_glyph_fn) {
 	VuiGlyphTextureId glyph_texture_id = vui_stbtt_get_styled_glyph_texture_id(font_id, line_height, codept);
 	_VuiStbttGlyphTexture* tex = _vui_stbtt_glyph_texture_get(glyph_texture_id);
 
 	//
 	// get the styled glyph from the glyph texture's internal list
-	uint32_t styled_glyph_id = _vui_stbtt_find_styled_glyph_id(tex, font_id, line_height, stb_glyph_idx);
+	uint32_t styled_glyph_id = _vui_stbtt_find_styled_glyph_id(tex, font_id, _vui_stbtt_glyph_texture_line_height(tex, line_height), stb_glyph_idx);
 	uint32_t rects_count = VuiStk_count(tex->styled_glyph_rects);
 	vui_assert(styled_glyph_id && styled_glyph_id <= rects_count, "unable to find codepoint '%lc' with a line_height of '%f' and a font_id of '%u'", codept, line_height, font_id);
 	_VuiStbttStyledGlyphRect* gr = &tex->styled_glyph_rects[styled_glyph_id - 1];
 
+	//
+	// the glyph is on screen, so keep it in the incremental mode. windows can be rendered on many threads at once.
+	_VuiStbttStyledGlyph* glyph = &tex->styled_glyphs[styled_glyph_id - 1];
+	_vui_atomic_store_u32(&glyph->last_used_pack_idx, tex->packs_count);
+	_vui_atomic_store_u8(&glyph->is_being_evicted, vui_false);
+
+	//
+	// in the SDF mode the glyph was rendered at vui_stbtt_sdf_line_height, so scale its offset to the line height of the text.
+	VuiRect offset = gr->offset;
+	if (tex->is_sdf) {
+		float scale = line_height / vui_stbtt_sdf_line_height;
+		offset = VuiRect_init(offset.x * scale, offset.y * scale, offset.ex * scale, offset.ey * scale);
+	}
+
 	//
 	// calculate the rectangle in screen space where the glyph will go.
 	VuiRect rect;
 	if (align_to_integer) {
-		float x = floorf((baseline_pos.x + gr->offset.x) + 0.5f);
-		float y = floorf((baseline_pos.y + gr->offset.y) + 0.5f);
+		float x = floorf((baseline_pos.x + offset.x) + 0.5f);
+		float y = floorf((baseline_pos.y + offset.y) + 0.5f);
 		rect.x = x;
 		rect.y = y;
-		rect.ex = x + VuiRect_width(&gr->offset);
-		rect.ey = y + VuiRect_height(&gr->offset);
+		rect.ex = x + VuiRect_width(&offset);
+		rect.ey = y + VuiRect_height(&offset);
 	} else {
-		rect.x = baseline_pos.x + gr->offset.x;
-		rect.y = baseline_pos.y + gr->offset.y;
-		rect.ex = baseline_pos.x + gr->offset.ex;
-		rect.ey = baseline_pos.y + gr->offset.ey;
+		rect.x = baseline_pos.x + offset.x;
+		rect.y = baseline_pos.y + offset.y;
+		rect.ex = baseline_pos.x + offset.ex;
+		rect.ey = baseline_pos.y + offset.ey;
 	}
 
 	//
@@ -568,12 +1341,24 @@ void vui_stbtt_render_glyph(VuiVec2 baseline_pos, VuiFontId font_id, float line_
 		(gr->tex.y + gr->tex.h) * ratio
 	);
 
+	//
+	// move the texture coordinates of SDF glyphs out of 0 to 1, so a shader knows to sample them as a distance.
+	if (tex->is_sdf) {
+		uv_rect.x += vui_stbtt_sdf_glyph_u_offset;
+		uv_rect.ex += vui_stbtt_sdf_glyph_u_offset;
+	}
+
 	//
 	// call the VUI callback function to render the glyph
 	render_glyph_fn(&rect, tex->texture_id, &uv_rect);
 }
 
 VuiBool vui_stbtt_found_glyph(VuiFontId font_id, float line_height, int32_t codept, int32_t stb_glyph_idx) {
+	//
+	// text that is measured while rendering was already measured when the window was built,
+	// and a glyph added now could not be packed before it is drawn.
+	if (vui_window_is_rendering()) return vui_true;
+
 	VuiGlyphTextureId glyph_texture_id = vui_stbtt_get_styled_glyph_texture_id(font_id, line_height, codept);
 	return vui_stbtt_glyph_texture_add_styled_glyph(glyph_texture_id, font_id, line_height, stb_glyph_idx);
 }
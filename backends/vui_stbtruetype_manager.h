@@ -13,17 +13,40 @@
 
 typedef uint32_t VuiGlyphTextureId;
 
+//
+// added to the u texture coordinate of the glyphs in an SDF glyph texture, see vui_stbtt_glyph_texture_set_sdf.
+#define vui_stbtt_sdf_glyph_u_offset 2.f
+
 //
 // YOU NEED TO IMPLEMENT this function to choose which glyph texture you want styled glyphs (font_id + line_height + codept) to go in.
 //
 // eg. you may want a group of fonts to use one glyph texture, and another group use a different texture.
 //
 // another eg. you may want to precompute a glyph for all ASCII characters at program start up: (codept >= 33 && codept <= 126)
-//             and then you may also want the rest of the unicode characters to be in a different that is glyph texture that is
-//             cleared and repacked every fram.
+//             and then you may also want the rest of the unicode characters to be in a different glyph texture that is
+//             cleared and repacked every frame, or kept in the incremental mode (see vui_stbtt_glyph_texture_set_incremental).
 //
 extern VuiGlyphTextureId (*vui_stbtt_get_styled_glyph_texture_id)(VuiFontId font_id, float line_height, int32_t codept);
 
+//
+// OPTIONAL: vui_stbtt_glyph_texture_pack renders the glyphs with this, it must call @param(fn) for every idx from 0 to @param(count) - 1
+// and only return once they have all finished. each call renders a different glyph to its own part of the texture, so they can run on many threads.
+// the calls read the fonts, so do not add or remove fonts while a pack is running.
+//
+// it is vui_stbtt_parallel_for_pthread by default, which starts threads for each call when there are enough glyphs.
+// if vui_stbtt_no_pthread is defined it is NULL by default and the glyphs are rendered on the calling thread,
+// set it to your own function to use the job system of your application.
+//
+extern void (*vui_stbtt_parallel_for)(uint32_t count, void (*fn)(uint32_t idx, void* ud), void* ud);
+
+#ifndef vui_stbtt_no_pthread
+//
+// the default vui_stbtt_parallel_for, it uses one thread for every vui_stbtt_pthread_min_jobs_per_thread jobs,
+// up to the number of CPUs and vui_stbtt_pthread_threads_cap. the calling thread does a share of the jobs too.
+//
+void vui_stbtt_parallel_for_pthread(uint32_t count, void (*fn)(uint32_t idx, void* ud), void* ud);
+#endif
+
 //
 // creates a font
 //
@@ -135,15 +158,119 @@ VuiBool vui_stbtt_glyph_texture_add_styled_glyph(VuiGlyphTextureId glyph_texture
 //
 void vui_stbtt_glyph_texture_clear_styled_glyphs(VuiGlyphTextureId glyph_texture_id);
 
+//
+// adds a single channel image to the glyph texture. it is packed along side the glyphs,
+// so small icons can be rendered in the same draw call as the text around them.
+// the pixels are copied, and the image is given its place in the texture when vui_stbtt_glyph_texture_pack is called.
+//
+// @param glyph_texture_id: the identifier of the glyph texture you want the image to live in.
+//
+// @param pixels: the coverage of the image, one byte per pixel and row by row.
+//
+// @param width, height: the size of the image in pixels.
+//
+// @return: a value of zero is returned on failure, otherwise an identifier that can be passed to vui_image and friends.
+//     the image has VuiImage.is_alpha_mask set, so it is tinted by the image_tint in the same way text is by its color.
+//
+VuiImageId vui_stbtt_glyph_texture_add_image(VuiGlyphTextureId glyph_texture_id, const uint8_t* pixels, uint32_t width, uint32_t height);
+
+//
+// removes an image that was added with vui_stbtt_glyph_texture_add_image.
+// the space it was using is given back the next time the glyph texture is packed.
+//
+// @param glyph_texture_id: the identifier of the glyph texture the image lives in.
+//
+// @param image_id: the identifier of the image you want to remove.
+//
+void vui_stbtt_glyph_texture_remove_image(VuiGlyphTextureId glyph_texture_id, VuiImageId image_id);
+
 //
 // this goes over internal list of styled glyphs and renders them to the internal pixel buffer.
+// the images of the glyph texture are copied in too.
 // if the pixel buffer cannot hold all of the glyphs, it will be doubled in size until it can.
 //
+// in the incremental mode, see vui_stbtt_glyph_texture_set_incremental, only the glyphs that have been added
+// since the last pack are placed and rendered, unless the whole texture needs packing again.
+//
+// packing the whole texture calls vui_invalidate_glyphs, so every VuiContext renders again and rebuilds its caches
+// on the next frame. outside of the incremental mode this happens on every pack, so the caches and window renders
+// are only reused between packs.
+//
 // @param glyph_texture_id: the identifier of the glyph texture.
 //
 // @return: vui_false on allocation failure and vui_true on success.
 //
 VuiBool vui_stbtt_glyph_texture_pack(VuiGlyphTextureId glyph_texture_id);
 
+//
+// turns the incremental mode of the glyph texture on or off, it is off by default.
+//
+// in the incremental mode the styled glyphs are kept between frames, so do not call vui_stbtt_glyph_texture_clear_styled_glyphs every frame.
+// vui_stbtt_glyph_texture_pack puts new glyphs in the empty space of the texture and renders only them.
+// everything is packed from scratch when the new glyphs do not fit,
+// or the space given back by evicted glyphs is over vui_stbtt_glyph_texture_compact_threshold of the texture.
+// this calls vui_invalidate_glyphs, which makes every VuiContext render again and measure its text again.
+// at that time the glyphs that have not been found while measuring text or rendered for vui_stbtt_glyph_texture_evict_after_packs
+// packs are marked, and they are evicted on the next pack if the text that is still on screen has not found them again.
+// so every context that uses the glyph texture must build a frame between packs.
+//
+// @param glyph_texture_id: the identifier of the glyph texture.
+//
+// @param is_incremental: vui_true to turn the incremental mode on.
+//
+void vui_stbtt_glyph_texture_set_incremental(VuiGlyphTextureId glyph_texture_id, VuiBool is_incremental);
+
+//
+// turns the SDF mode of the glyph texture on or off, it is off by default. this removes all of the styled glyphs in the texture.
+//
+// in the SDF mode a glyph is rendered once as a signed distance field at vui_stbtt_sdf_line_height with stbtt_GetGlyphSDF,
+// and that is used for the glyph at every line height by scaling its quad. so text that changes size does not need new glyphs.
+// the texture is still single channel, the distance is 128 on the outline of the glyph, higher inside and lower outside.
+// vui_stbtt_sdf_glyph_u_offset is added to the u of the texture coordinates of these glyphs, so a shader can tell them apart
+// from the other alpha masks. see vui_opengl_sdf_glyph_fragment_shader_src in backends/vui_opengl.h for a reference shader.
+// the oversample of the glyph texture is not used, and this cannot be used with VUI_COMPACT_VERTEX.
+//
+// @param glyph_texture_id: the identifier of the glyph texture.
+//
+// @param is_sdf: vui_true to turn the SDF mode on.
+//
+void vui_stbtt_glyph_texture_set_sdf(VuiGlyphTextureId glyph_texture_id, VuiBool is_sdf);
+
+//
+// gets a number that changes whenever vui_stbtt_glyph_texture_pack moves or evicts glyphs that were already in the texture.
+// the caches and window renders that hold the texture coordinates of the glyphs are already dropped by vui_invalidate_glyphs
+// when this changes, this is for renderers that keep their own copies of the vertices.
+//
+// @param glyph_texture_id: the identifier of the glyph texture.
+//
+uint32_t vui_stbtt_glyph_texture_get_generation(VuiGlyphTextureId glyph_texture_id);
+
+//
+// gets the number of rectangles of the texture that the last vui_stbtt_glyph_texture_pack wrote pixels to.
+// only these need to be sent to the GPU, eg. with glTexSubImage2D, get them with vui_stbtt_glyph_texture_get_dirty_rect.
+// when the whole texture has been packed again, there is a single rectangle that covers all of it.
+//
+// @param glyph_texture_id: the identifier of the glyph texture.
+//
+// @param is_resized_out: if not NULL, vui_true is written here when the width and height of the texture are different to
+//                        what they were after the pack before (or this is the first pack). the GPU texture needs to be recreated.
+//
+// @return: the number of dirty rectangles.
+//
+uint32_t vui_stbtt_glyph_texture_get_dirty_rects_count(VuiGlyphTextureId glyph_texture_id, VuiBool* is_resized_out);
+
+//
+// gets a rectangle of the texture that the last vui_stbtt_glyph_texture_pack wrote pixels to.
+// the pixels are in the buffer from vui_stbtt_glyph_texture_get_pixels_and_wh, so each row of the rectangle
+// is width_and_height bytes after the one before.
+//
+// @param glyph_texture_id: the identifier of the glyph texture.
+//
+// @param idx: the index of the rectangle, must be less than vui_stbtt_glyph_texture_get_dirty_rects_count.
+//
+// @param x_out, y_out, width_out, height_out: the rectangle in pixels is written here.
+//
+void vui_stbtt_glyph_texture_get_dirty_rect(VuiGlyphTextureId glyph_texture_id, uint32_t idx, uint32_t* x_out, uint32_t* y_out, uint32_t* width_out, uint32_t* height_out);
+
 #endif // VUI_STBTT_MANAGER_H
 
@@ -30,6 +30,24 @@
 #define screen_width 1280
 #define screen_height 720
 
+//
+// compile with -DAPP_SDF_GLYPHS=1 to render the etc glyph texture as signed distance fields, see vui_stbtt_glyph_texture_set_sdf.
+#ifndef APP_SDF_GLYPHS
+#define APP_SDF_GLYPHS 0
+#endif
+
+#if VUI_COMPACT_VERTEX
+
+#define vertex_shader_src vui_opengl_compact_vertex_shader_src
+#define fragment_shader_src vui_opengl_compact_fragment_shader_src
+
+#elif VUI_SDF_SHAPES
+
+#define vertex_shader_src vui_opengl_sdf_vertex_shader_src
+#define fragment_shader_src vui_opengl_sdf_fragment_shader_src
+
+#else // VUI_SDF_SHAPES
+
 const char* vertex_shader_src =
 	"#version 330 core\n"
 	"layout(location = 0) in vec2 v_pos;\n"
@@ -44,6 +62,12 @@ const char* vertex_shader_src =
 	"  f_color = v_color;\n"
 	"}";
 
+#if APP_SDF_GLYPHS
+
+#define fragment_shader_src vui_opengl_sdf_glyph_fragment_shader_src
+
+#else // APP_SDF_GLYPHS
+
 const char* fragment_shader_src =
 	"#version 330 core\n"
 	"smooth in vec2 f_uv;\n"
@@ -60,6 +84,10 @@ const char* fragment_shader_src =
 	"  }\n"
 	"}";
 
+#endif // APP_SDF_GLYPHS
+
+#endif // VUI_SDF_SHAPES
+
 typedef enum {
 	AppWindowId_main,
 	AppWindowId_COUNT,
@@ -392,7 +420,32 @@ void glyph_texture_pack_and_update(VuiGlyphTextureId glyph_texture_id, GLuint te
 
 	uint32_t wh = 0;
 	uint8_t* pixels = vui_stbtt_glyph_texture_get_pixels_and_wh(glyph_texture_id, &wh);
-	opengl_texture_set_pixels(texture_id, GL_R8, GL_RED, wh, wh, pixels);
+
+	//
+	// when the texture has changed size, it needs creating again with all of the pixels.
+	VuiBool is_resized = vui_false;
+	uint32_t dirty_rects_count = vui_stbtt_glyph_texture_get_dirty_rects_count(glyph_texture_id, &is_resized);
+	if (is_resized) {
+		opengl_texture_set_pixels(texture_id, GL_R8, GL_RED, wh, wh, pixels);
+		return;
+	}
+
+	if (dirty_rects_count == 0)
+		return;
+
+	//
+	// otherwise only send the parts of the texture that the pack has written to.
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, wh);
+	for (uint32_t i = 0; i < dirty_rects_count; i += 1) {
+		uint32_t x, y, w, h;
+		vui_stbtt_glyph_texture_get_dirty_rect(glyph_texture_id, i, &x, &y, &w, &h);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE, pixels + x + (uintptr_t)y * wh);
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 //
@@ -416,16 +469,17 @@ static void app_button_animate_fn(VuiCtrl* ctrl, float dt, float interp_ratio, V
 	if (interp_ratio == 1.f)
 		return;
 
+	VuiCtrlAnimateAux* aux = &vui_ctrl_cold(ctrl)->animate_aux;
 	if (changed_this_frame) {
-		ctrl->animate_aux.pos = vui_mouse_pos();
+		aux->pos = vui_mouse_pos();
 	}
 
 	if (ctrl->prev_state != VuiCtrlState_active && ctrl->state == VuiCtrlState_active) {
 		float radius = vui_lerp(25.f, 0.f, interp_ratio);
-		vui_render_circle(ctrl->animate_aux.pos, radius, ctrl->styles[ctrl->state].bg_color);
+		vui_render_circle(aux->pos, radius, ctrl->styles[ctrl->state].bg_color);
 	} else if (ctrl->prev_state == VuiCtrlState_active && ctrl->state != VuiCtrlState_active) {
 		float radius = vui_lerp(0.f, 25.f, interp_ratio);
-		vui_render_circle(ctrl->animate_aux.pos, radius, ctrl->styles[ctrl->state].bg_color);
+		vui_render_circle(aux->pos, radius, ctrl->styles[ctrl->state].bg_color);
 	}
 }
 
@@ -434,23 +488,24 @@ static void app_progress_bar_animate_fn(VuiCtrl* ctrl, float dt, float interp_ra
 	// this example shows off adding extra animations that constantly persist
 	//
 	VuiCtrl* inner_bar_ctrl = vui_ctrl_get(ctrl->child_first_id);
+	VuiCtrlAnimateAux* aux = &vui_ctrl_cold(ctrl)->animate_aux;
 	VuiVec2 size = VuiVec2_init(6.f, VuiRect_height(&inner_bar_ctrl->rect));
 
 	float max = VuiRect_width(&inner_bar_ctrl->rect);
 	if (max < 30.f) {
-		ctrl->animate_aux.pos.x = 0.f;
+		aux->pos.x = 0.f;
 		return;
 	}
 
 	float speed = 0.1f;
 
-	ctrl->animate_aux.pos.x += speed * dt;
-	if (ctrl->animate_aux.pos.x + size.x > max) {
-		ctrl->animate_aux.pos.x = 0.f;
+	aux->pos.x += speed * dt;
+	if (aux->pos.x + size.x > max) {
+		aux->pos.x = 0.f;
 	}
 
 	VuiRect rect;
-	rect.left_top = VuiVec2_add(inner_bar_ctrl->rect.left_top, ctrl->animate_aux.pos);
+	rect.left_top = VuiVec2_add(inner_bar_ctrl->rect.left_top, aux->pos);
 	rect.right_bottom = VuiVec2_add(rect.left_top, size);
 
 	VuiColor color = VuiColor_white;
@@ -507,6 +562,17 @@ void App_init() {
 	app.ascii_glyph_texture_id = vui_stbtt_glyph_texture_add(app.opengl.tex_ascii_glyph_texture, 0, 0, 0, 0);
 	app.etc_glyph_texture_id = vui_stbtt_glyph_texture_add(app.opengl.tex_etc_glyph_texture, 0, 0, 0, 0);
 
+	//
+	// the glyphs of the etc glyph texture are kept between frames and the ones that are no longer used are evicted.
+	// this means the text sizes can be cached, as the glyphs do not need to be found every frame.
+	vui_stbtt_glyph_texture_set_incremental(app.etc_glyph_texture_id, vui_true);
+
+#if APP_SDF_GLYPHS
+	//
+	// each glyph of the etc glyph texture is rendered once as a distance field and scaled to every line height.
+	vui_stbtt_glyph_texture_set_sdf(app.etc_glyph_texture_id, vui_true);
+#endif
+
 	//
 	// initialize VUI.
 	// we pass in the position text function from the vui stb truetype shim.
@@ -518,6 +584,7 @@ void App_init() {
 		.windows_count = 1,
 		.allocator = NULL,
 		.default_font_id = app.default_font_id,
+		.text_size_cache = vui_true,
 	};
 	vui_assert(vui_init(&setup), "failed to initialize vui");
 	vui_ss.button_action[0].pre_animate_fn = app_button_animate_fn;
@@ -549,7 +616,7 @@ void App_init() {
 	// this can be done at anytime if images are dynamically loaded.
 	//
 	{
-		VuiImage image;
+		VuiImage image = {0};
 
 		uint32_t wh = 0;
 		vui_stbtt_glyph_texture_get_pixels_and_wh(app.ascii_glyph_texture_id, &wh);
@@ -626,11 +693,6 @@ void App_update() {
 	app.dt = (double)((frame_start_time - app.last_frame_start_time)*1000) / (double)SDL_GetPerformanceFrequency();
 	app.last_frame_start_time = frame_start_time;
 
-
-	//
-	// remove all the glyphs from the glyph texture that holds all the different sized or non ASCII glyphs.
-	vui_stbtt_glyph_texture_clear_styled_glyphs(app.etc_glyph_texture_id);
-
 	//
 	// transfer all the information that VUI needs from SDL.
 	vui_sdl2_frame_start();
@@ -638,7 +700,7 @@ void App_update() {
 	build_ui();
 
 	//
-	// pack the etc glyph texture and send the pixels to the GPU.
+	// pack the glyphs that were found for the first time this frame in to the etc glyph texture and send the pixels to the GPU.
 	glyph_texture_pack_and_update(app.etc_glyph_texture_id, app.opengl.tex_etc_glyph_texture);
 }
 
@@ -646,6 +708,9 @@ void vui_opengl_setup_state() {
 	glUseProgram(app.opengl.program);
 	glUniformMatrix4fv(glGetUniformLocation(app.opengl.program, "u_mvp"), 1, GL_FALSE, app.opengl.projection);
 
+#if VUI_COMPACT_VERTEX
+	vui_opengl_setup_compact_vertex_attribs();
+#else
 	glEnableVertexAttribArray(0);
 	glEnableVertexAttribArray(1);
 	glEnableVertexAttribArray(2);
@@ -653,6 +718,10 @@ void vui_opengl_setup_state() {
 	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, pos));
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, uv));
 	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VuiVertex), (const void*)offsetof(VuiVertex, color));
+#if VUI_SDF_SHAPES
+	vui_opengl_setup_sdf_vertex_attribs();
+#endif
+#endif
 }
 
 void App_render() {
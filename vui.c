@@ -5,6 +5,15 @@
 #include <stddef.h>
 #include <stdarg.h>
 #include <signal.h>
+#include <float.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define _vui_sse2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define _vui_neon 1
+#include <arm_neon.h>
+#endif
 
 // ===========================================================================================
 //
@@ -15,6 +24,9 @@
 // ===========================================================================================
 
 #define _vui_ctrls_init_cap 4096
+#define _vui_damage_rects_max 16
+#define _vui_unit_arc_points_max 1025
+#define _vui_vertex_idx_max ((uint64_t)(VuiVertexIdx)-1)
 #define _VuiArenaAlctor_arena_size 8192
 
 typedef struct {
@@ -53,14 +65,18 @@ void* _VuiArenaAlctor_alloc(_VuiArenaAlctor* alctor, uintptr_t size, uintptr_t a
 			alctor->pos = next_pos;
 			return ptr;
 		} else {
-			// allocate a new arena
-			void* arena = vui_mem_alloc(_vui.allocator, _VuiArenaAlctor_arena_size, 1);
-			// add it to the arena link list
-			((_VuiArenaHeader*)alctor->arena)->next = arena;
-			// now make it the current arena and zero its memory
+			// reuse the next arena from a previous frame, otherwise allocate a new one.
+			void* arena = ((_VuiArenaHeader*)alctor->arena)->next;
+			if (!arena) {
+				arena = vui_mem_alloc(_vui.allocator, _VuiArenaAlctor_arena_size, 1);
+				((_VuiArenaHeader*)arena)->next = NULL;
+				// add it to the arena link list
+				((_VuiArenaHeader*)alctor->arena)->next = arena;
+			}
+			// now make it the current arena and zero its memory, keeping the link to the next one.
 			alctor->arena = arena;
 			alctor->pos = sizeof(_VuiArenaHeader);
-			memset(alctor->arena, 0, _VuiArenaAlctor_arena_size);
+			memset(alctor->arena + alctor->pos, 0, _VuiArenaAlctor_arena_size - alctor->pos);
 		}
 	}
 }
@@ -94,14 +110,64 @@ struct VuiRenderLayer {
 	VuiStk(VuiVertexIdx) indices;
 };
 
-typedef struct {
+//
+// a run of render commands that are merged in to one, see _vui_render_layer_merge_cmds.
+typedef struct _VuiRenderBatch _VuiRenderBatch;
+struct _VuiRenderBatch {
+	VuiRect bounds;
+	uint32_t first_cmd_idx;
+	uint32_t last_cmd_idx;
+	uint32_t indices_count;
+};
+
+typedef struct _VuiWindow _VuiWindow;
+
+//
+// the data that is used when rendering the UI tree of a window.
+// this is the third stage of the pipeline. each window has its own,
+// so different windows can be rendered on different threads at the same time.
+typedef struct _VuiRenderState _VuiRenderState;
+struct _VuiRenderState {
+	_VuiWindow* w;
+	VuiRect clip_rect;
+	uint32_t layer_idx;
+	VuiStk(VuiVec2) path_points;
+	// the color of the text that _vui_render_glyph is rendering.
+	VuiColor glyph_color;
+	// indexed by an arc's points count, see _vui_unit_arc_get.
+	VuiStk(VuiVec2*) unit_arcs;
+	// scratch space for _vui_render_layer_merge_cmds.
+	VuiStk(_VuiRenderBatch) merge_batches;
+	VuiStk(uint32_t) merge_next_cmd_idxs;
+	VuiStk(VuiRenderCmd) merge_cmds;
+	VuiStk(VuiVertexIdx) merge_indices;
+};
+
+struct _VuiWindow {
 	VuiCtrlId root_ctrl_id;
 	VuiVec2 size;
     VuiCtrlId focused_ctrl_id;
 	VuiStk(char) text;
 	VuiStk(VuiRenderLayer) render_layers;
 	VuiWindowRender render;
-} _VuiWindow;
+
+	//
+	// the render_bounds of the controls that have been removed since the last render.
+	VuiStk(VuiRect) removed_ctrl_bounds;
+	VuiVec2 render_size;
+	float render_scale_factor;
+
+	//
+	// a hash of everything the controls render from, computed while building.
+	// if it matches the one of the last render, the last render is still valid.
+	// a build_hash of 0 means the window must be rendered.
+	uint64_t build_hash;
+	uint64_t render_build_hash;
+	VuiBool render_pixel_snapping;
+	// the _vui_renders_epoch when the window was last rendered, see vui_invalidate_renders.
+	uint32_t render_renders_epoch;
+	_VuiRenderState render_state;
+};
 
 typedef uint8_t VuiCtrlAttrType;
 enum {
@@ -121,8 +187,9 @@ struct VuiCtrlAttrChange {
 typedef uint32_t _VuiFlags;
 enum {
 	_VuiFlags_out_of_memory = 0x1,
-	_VuiFlags_pixel_snapping = 0x2,
 	_VuiFlags_right_to_left = 0x4,
+	_VuiFlags_scissor_clipping = 0x8,
+	_VuiFlags_text_size_cache = 0x10,
 };
 
 typedef struct _VuiImage _VuiImage;
@@ -138,7 +205,123 @@ struct _VuiCtrl {
 	uint16_t counter;
 };
 typedef_VuiPool(_VuiCtrl);
+
+//
+// an entry in the _VuiCtrlSibTable. a ctrl_id of 0 marks the entry as empty.
+typedef struct {
+	VuiCtrlId parent_id;
+	VuiCtrlSibId sib_id;
+	VuiCtrlId ctrl_id;
+} _VuiCtrlSibEntry;
+
+//
+// open addressing hash table (linear probing) that maps a (parent_id, sib_id) to the child control.
+// this stops vui_ctrl_start_ from having to walk all the siblings to find a control.
+typedef struct {
+	_VuiCtrlSibEntry* entries;
+	uint32_t count;
+	uint32_t cap; // always a power of two
+} _VuiCtrlSibTable;
+
+//
+// an entry in the _VuiTextSizeCache. the text is only kept as a hash.
+typedef struct {
+	uint64_t text_hash;
+	uint32_t text_length;
+	VuiFontId font_id;
+	float line_height;
+	float word_wrap_at_width;
+	VuiVec2 size;
+	uint32_t lru_prev_idx;
+	uint32_t lru_next_idx;
+} _VuiTextSizeCacheEntry;
+
+//
+// the entries are in a list from the most to least recently used, so the least recently used can be replaced when it is full.
+// they are found with an open addressing hash table (linear probing) of entry indices + 1, where 0 marks an empty slot.
+typedef struct {
+	_VuiTextSizeCacheEntry* entries;
+	uint32_t* slots;
+	uint32_t slots_cap; // always a power of two
+	uint32_t count;
+	uint32_t lru_head_idx;
+	uint32_t lru_tail_idx;
+	// the _vui_glyphs_epoch when the cache was last cleared, see vui_invalidate_glyphs.
+	uint32_t glyphs_epoch;
+	VuiTextSizeCacheStats stats;
+} _VuiTextSizeCache;
+
+//
+// a run of vertices and indices that use the same texture in the render output of a cache.
+typedef struct {
+	VuiTextureId texture_id;
+	VuiRect clip_rect;
+	uint32_t verts_count;
+	uint32_t indices_count;
+} _VuiCacheRenderCmd;
+
+//
+// the inputs of _vui_layout_ctrls for a cache and the relative rectangle it produced.
+typedef struct {
+	VuiBool is_valid;
+	VuiBool right_to_left;
+	VuiCtrlAttrs attributes;
+	VuiRect placement_area;
+	VuiVec2 parent_inner_size;
+	VuiVec2 fill_portion;
+	VuiRect rect;
+} _VuiCacheLayout;
+
+#ifndef _VUI_CACHE_LAYOUTS_COUNT
+// a parent can lay out its children more than once per frame, an auto sized parent measures them first.
+#define _VUI_CACHE_LAYOUTS_COUNT 2
+#endif
+
+//
+// the retained data for a control started with vui_cache_start.
+// this is stored in a separate pool so it does not bloat every VuiCtrl.
 typedef struct {
+	uint64_t content_hash;
+	VuiCtrlId outer_cache_ctrl_id;
+	uint32_t built_frame_idx;
+	VuiCtrlStateFlags state_flags;
+	VuiBool is_built;
+	// the _vui_renders_epoch when it was built, see vui_invalidate_renders.
+	uint32_t built_renders_epoch;
+	// set when something in the subtree can change without the content hash changing.
+	// e.g. a style transition is in progress or the user is interacting with a control.
+	VuiBool needs_rebuild;
+
+	//
+	// build: a copy of the text the subtree pushed to _VuiWindow.text
+	VuiStk(char) text;
+	uint32_t text_start_idx;
+	// the structural hash of the subtree, so it can be added to the window's on a hit.
+	uint64_t build_hash;
+	uint64_t outer_build_hash;
+
+	//
+	// layout: the children hold the result of laying out with layouts[children_layout_idx].
+	// when is_layout_absolute is set, they have been finalized at the absolute rectangle in rect.
+	_VuiCacheLayout layouts[_VUI_CACHE_LAYOUTS_COUNT];
+	uint8_t children_layout_idx;
+	uint8_t skipped_layout_idx;
+	VuiBool is_layout_absolute;
+	VuiRect rect;
+
+	//
+	// render: the output of _vui_render_ctrls with the indices relative to the first vertex.
+	VuiBool is_render_valid;
+	uint32_t render_built_frame_idx;
+	VuiRect render_rect;
+	VuiRect render_clip_rect;
+	VuiStk(_VuiCacheRenderCmd) render_cmds;
+	VuiStk(VuiVertex) render_verts;
+	VuiStk(VuiVertexIdx) render_indices;
+} _VuiCache;
+typedef_VuiPool(_VuiCache);
+
+struct VuiContext {
 	VuiPositionTextFn position_text_fn;
 	void* position_text_userdata;
 	void* allocator;
@@ -153,7 +336,15 @@ typedef struct {
 	VuiCtrlId mouse_focused_ctrl_id;
 
 	VuiPool(_VuiCtrl) ctrl_pool;
+	// indexed by the pool id - 1 of a control. grows with the ctrl_pool so it always has the same capacity.
+	VuiCtrlCold* ctrl_colds;
+	uint32_t ctrl_colds_cap;
+	_VuiCtrlSibTable ctrl_sib_table;
+	_VuiTextSizeCache text_size_cache;
+	// incremented by vui_invalidate_renders, the caches and window renders from before it are not reused.
+	uint32_t renders_epoch;
 	VuiPool(_VuiImage) image_pool;
+	VuiPool(_VuiCache) cache_pool;
 	_VuiArenaAlctor frame_data_alctor;
 
 	struct {
@@ -197,6 +388,7 @@ typedef struct {
 		float dt;
 		VuiCtrlId parent_ctrl_id;
 		VuiCtrlId sibling_prev_ctrl_id;
+		VuiCtrlId cache_ctrl_id;
 		float fill_portion_width;
 		float fill_portion_height;
 		VuiCtrlAttrChange* ctrl_attr_change_list_heads[VuiCtrlAttr_COUNT];
@@ -205,20 +397,43 @@ typedef struct {
 		VuiVec2* mouse_scroll_focused_size;
 		VuiStk(VuiBool) disabled_stack;
 		VuiStk(VuiCtrlId) popover_ctrl_ids;
+		uint64_t hash;
+		// set when something is animating, so the window's render cannot be reused.
+		VuiBool is_render_forced;
 	} build;
+};
+typedef VuiContext _Vui;
+
+#if defined(_MSC_VER)
+#define _vui_thread_local __declspec(thread)
+#elif defined(__GNUC__)
+#define _vui_thread_local __thread
+#else
+#define _vui_thread_local _Thread_local
+#endif
 
-	//
-	// the data that is used when rendering the UI tree.
-	// this is the third stage of the pipeline.
-	struct {
-		_VuiWindow* w;
-		VuiRect clip_rect;
-		uint32_t layer_idx;
-		VuiStk(VuiVec2) path_points;
-	} render;
-} _Vui;
+//
+// the context the API uses on this thread, see vui_context_set_current.
+// every thread starts out with the default context, so an application with a single UI never has to set one.
+static _Vui _vui_default_ctx;
+static _vui_thread_local _Vui* _vui_ctx = &_vui_default_ctx;
+#define _vui (*_vui_ctx)
+
+//
+// the render state of the window that is being rendered on this thread, see vui_window_render.
+static _vui_thread_local _VuiRenderState* _vui_render_state;
+#define _vui_render (*_vui_render_state)
 
-_Vui _vui = {0};
+//
+// incremented by vui_invalidate_glyphs, this is shared by every context as they can share glyph textures.
+static uint32_t _vui_glyphs_epoch;
+
+//
+// the caches and window renders are only reused when this is the same as when they were made.
+// both of the epochs only go up, so their sum changes whenever either of them does.
+static inline uint32_t _vui_renders_epoch() {
+	return _vui.renders_epoch + _vui_atomic_load_u32(&_vui_glyphs_epoch);
+}
 
 VuiCtrlAttrType VuiCtrlAttr_types[VuiCtrlAttr_COUNT] = {
 	[VuiCtrlAttr_width] = VuiCtrlAttrType_float,
@@ -366,22 +581,40 @@ static inline void _VuiPool_set_free(_VuiPool* pool, uint32_t idx) {
 	((uint8_t*)pool->data)[idx / 8] &= ~(1 << (idx % 8));
 }
 
-void _VuiPool_reset(_VuiPool* pool, uintptr_t elmt_size) {
+void _VuiPool_reset(_VuiPool* pool) {
 	//
 	// set all the bits to 0 so all elements are marked as free
 	uint8_t* is_alloced_bitset = pool->data;
 	memset(is_alloced_bitset, 0, pool->elmts_start_byte_idx);
+	pool->count = 0;
+	pool->free_search_idx = 0;
+}
 
-	//
-	// now go through and set up the link list, so every element points to the next.
-	void* elmts = vui_ptr_add(pool->data, pool->elmts_start_byte_idx);
-	uintptr_t cap = pool->cap;
-	for (uintptr_t i = 0; i < cap; i += 1) {
-		// + 2 instead of 1 because we use id's here and not indexes.
-		*(uintptr_t*)vui_ptr_add(elmts, i * elmt_size) = i + 2;
+//
+// returns the index of the lowest element that is free.
+// every element below pool->free_search_idx is allocated, so the search starts there.
+// 64 elements are skipped at a time while they are all allocated.
+static uint32_t _VuiPool_find_free_idx(_VuiPool* pool) {
+	uint8_t* is_alloced_bitset = pool->data;
+	uint32_t byte_idx = pool->free_search_idx / 8;
+	uint32_t bytes_count = (pool->cap + 7) / 8;
+
+	while (byte_idx + sizeof(uint64_t) <= bytes_count) {
+		uint64_t bits;
+		memcpy(&bits, &is_alloced_bitset[byte_idx], sizeof(uint64_t));
+		if (bits != UINT64_MAX) break;
+		byte_idx += sizeof(uint64_t);
 	}
-	pool->count = 0;
-	pool->free_list_head_id = 1;
+
+	while (byte_idx < bytes_count && is_alloced_bitset[byte_idx] == 0xff) {
+		byte_idx += 1;
+	}
+
+	uint32_t idx = byte_idx * 8;
+	while (idx < pool->cap && _VuiPool_is_allocated(pool, idx)) {
+		idx += 1;
+	}
+	return idx;
 }
 
 VuiBool _VuiPool_resize_cap(_VuiPool* pool, uint32_t new_cap, uintptr_t elmt_size, uintptr_t elmt_align) {
@@ -424,22 +657,14 @@ VuiBool _VuiPool_resize_cap(_VuiPool* pool, uint32_t new_cap, uintptr_t elmt_siz
 		vui_mem_dealloc(_vui.allocator, data, cap_bytes, alignof(uint8_t));
 	}
 
-	//
-	// setup the free list, by visiting each element and store an
-	// index to the next element.
-	for (uint32_t i = pool->cap; i < new_cap; i += 1) {
-		*(uint32_t*)vui_ptr_add(vui_ptr_add(new_data, new_bitset_size), i * elmt_size) = i + 2;
-	}
-
 	pool->data = new_data;
-	pool->free_list_head_id = pool->cap + 1;
 	pool->cap = new_cap;
 	pool->elmts_start_byte_idx = new_bitset_size;
 	return vui_true;
 }
 
 VuiBool _VuiPool_reset_and_populate(_VuiPool* pool, void* elmts, uint32_t count, uintptr_t elmt_size, uintptr_t elmt_align) {
-	_VuiPool_reset(pool, elmt_size);
+	_VuiPool_reset(pool);
 	if (pool->cap < count) {
 		if (!_VuiPool_resize_cap(pool, vui_max(pool->cap ? pool->cap * 2 : 64, count), elmt_size, elmt_align))
 			return vui_false;
@@ -456,7 +681,7 @@ VuiBool _VuiPool_reset_and_populate(_VuiPool* pool, void* elmts, uint32_t count,
 	// copy the elements and set the values in the pool structure
 	memcpy(vui_ptr_add(pool->data, pool->elmts_start_byte_idx), elmts, (uintptr_t)count * elmt_size);
 	pool->count = count;
-	pool->free_list_head_id = count + 1;
+	pool->free_search_idx = count;
 
 	return vui_true;
 }
@@ -470,8 +695,7 @@ void _VuiPool_init(_VuiPool* pool, uint32_t cap, uintptr_t elmt_size, uintptr_t
 
 	pool->elmts_start_byte_idx = elmts_start_byte_idx;
 	pool->cap = cap;
-	_VuiPool_reset(pool, elmt_size);
-	pool->free_list_head_id = 1;
+	_VuiPool_reset(pool);
 }
 
 void _VuiPool_deinit(_VuiPool* pool, uintptr_t elmt_size, uintptr_t elmt_align) {
@@ -490,12 +714,13 @@ void* _VuiPool_alloc(_VuiPool* pool, VuiPoolId* id_out, uintptr_t elmt_size, uin
 	}
 
 	//
-	// allocate an element and remove it from the free list
-	uintptr_t alloced_id = pool->free_list_head_id;
-	vui_debug_assert(!_VuiPool_is_allocated(pool, alloced_id - 1), "allocated element is in the free list of the pool");
-	_VuiPool_set_allocated(pool, alloced_id - 1);
-	uint32_t* alloced_elmt = (uint32_t*)vui_ptr_add(pool->data, (uintptr_t)pool->elmts_start_byte_idx + ((alloced_id - 1) * elmt_size));
-	pool->free_list_head_id = *alloced_elmt;
+	// allocate the lowest free element, to try to keep allocations near eachother.
+	uint32_t alloced_idx = _VuiPool_find_free_idx(pool);
+	vui_debug_assert(alloced_idx < pool->cap, "the pool has a count less than the cap but there are no free elements");
+	_VuiPool_set_allocated(pool, alloced_idx);
+	void* alloced_elmt = vui_ptr_add(pool->data, (uintptr_t)pool->elmts_start_byte_idx + ((uintptr_t)alloced_idx * elmt_size));
+	uint32_t alloced_id = alloced_idx + 1;
+	pool->free_search_idx = alloced_id;
 
 	pool->count += 1;
 	*id_out = alloced_id;
@@ -509,25 +734,13 @@ void _VuiPool_assert_id(_VuiPool* pool, uint32_t elmt_id) {
 	vui_debug_assert(_VuiPool_is_allocated(pool, elmt_id - 1), "cannot get pointer to a element that is not allocated");
 }
 
-void _VuiPool_dealloc(_VuiPool* pool, uint32_t elmt_id, uintptr_t elmt_size, uintptr_t elmt_align) {
+void _VuiPool_dealloc(_VuiPool* pool, uint32_t elmt_id) {
 	_VuiPool_assert_id(pool, elmt_id);
 
-	uint32_t* elmt_next_free_id = &pool->free_list_head_id;
-	void* elmts = vui_ptr_add(pool->data, pool->elmts_start_byte_idx);
-	//
-	// the free list is stored in low to high order, to try to keep allocations near eachother.
-	// move up the free list until elmt_id is less than that node.
-	while (1) {
-		uint32_t nfi = *elmt_next_free_id;
-		if (nfi > elmt_id || nfi == pool->cap) break;
-		elmt_next_free_id = (uint32_t*)vui_ptr_add(elmts, ((uintptr_t)nfi - 1) * elmt_size);
-	}
-
 	_VuiPool_set_free(pool, elmt_id - 1);
-	// point to the next element in the list
-	*(uint32_t*)vui_ptr_add(pool->data, (uintptr_t)pool->elmts_start_byte_idx + ((uintptr_t)(elmt_id - 1) * elmt_size)) = *elmt_next_free_id;
-	// get the previous element to point to this newly deallocated block
-	*elmt_next_free_id = elmt_id;
+	if (elmt_id - 1 < pool->free_search_idx) {
+		pool->free_search_idx = elmt_id - 1;
+	}
 	pool->count -= 1;
 }
 
@@ -540,6 +753,129 @@ VuiPoolId _VuiPool_ptr_to_id(_VuiPool* pool, void* ptr, uintptr_t elmt_size) {
 	return (vui_ptr_diff(ptr, vui_ptr_add(pool->data, (uintptr_t)pool->elmts_start_byte_idx)) / elmt_size) + 1;
 }
 
+// ===========================================================================================
+//
+//
+// control sibling lookup - open addressing hash table
+//
+//
+// ===========================================================================================
+
+#define _VuiCtrlSibTable_init_cap 1024
+
+static inline uint32_t _VuiCtrlSibTable_hash(VuiCtrlId parent_id, VuiCtrlSibId sib_id) {
+	uint32_t hash = parent_id * 0x9e3779b1 ^ sib_id;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	return hash;
+}
+
+static void _VuiCtrlSibTable_insert_no_grow(_VuiCtrlSibTable* table, VuiCtrlId parent_id, VuiCtrlSibId sib_id, VuiCtrlId ctrl_id) {
+	uint32_t mask = table->cap - 1;
+	uint32_t idx = _VuiCtrlSibTable_hash(parent_id, sib_id) & mask;
+	while (1) {
+		_VuiCtrlSibEntry* entry = &table->entries[idx];
+		if (entry->ctrl_id == 0) {
+			table->count += 1;
+			break;
+		}
+		if (entry->parent_id == parent_id && entry->sib_id == sib_id) break;
+		idx = (idx + 1) & mask;
+	}
+
+	_VuiCtrlSibEntry* entry = &table->entries[idx];
+	entry->parent_id = parent_id;
+	entry->sib_id = sib_id;
+	entry->ctrl_id = ctrl_id;
+}
+
+VuiBool _VuiCtrlSibTable_resize_cap(_VuiCtrlSibTable* table, uint32_t new_cap) {
+	_VuiCtrlSibEntry* new_entries = vui_mem_alloc_array(_VuiCtrlSibEntry, _vui.allocator, new_cap);
+	if (new_entries == NULL) {
+		_vui.flags |= _VuiFlags_out_of_memory;
+		return vui_false;
+	}
+	memset(new_entries, 0, new_cap * sizeof(_VuiCtrlSibEntry));
+
+	_VuiCtrlSibEntry* entries = table->entries;
+	uint32_t cap = table->cap;
+	table->entries = new_entries;
+	table->cap = new_cap;
+	table->count = 0;
+
+	//
+	// rehash all the existing entries into the new buffer.
+	if (entries) {
+		for (uint32_t i = 0; i < cap; i += 1) {
+			_VuiCtrlSibEntry* entry = &entries[i];
+			if (entry->ctrl_id) {
+				_VuiCtrlSibTable_insert_no_grow(table, entry->parent_id, entry->sib_id, entry->ctrl_id);
+			}
+		}
+		vui_mem_dealloc_array(_VuiCtrlSibEntry, _vui.allocator, entries, cap);
+	}
+	return vui_true;
+}
+
+VuiCtrlId _VuiCtrlSibTable_get(_VuiCtrlSibTable* table, VuiCtrlId parent_id, VuiCtrlSibId sib_id) {
+	if (table->count == 0) return 0;
+	uint32_t mask = table->cap - 1;
+	uint32_t idx = _VuiCtrlSibTable_hash(parent_id, sib_id) & mask;
+	while (1) {
+		_VuiCtrlSibEntry* entry = &table->entries[idx];
+		if (entry->ctrl_id == 0) return 0;
+		if (entry->parent_id == parent_id && entry->sib_id == sib_id) return entry->ctrl_id;
+		idx = (idx + 1) & mask;
+	}
+}
+
+void _VuiCtrlSibTable_set(_VuiCtrlSibTable* table, VuiCtrlId parent_id, VuiCtrlSibId sib_id, VuiCtrlId ctrl_id) {
+	//
+	// keep the load factor under 50% so the probe sequences stay short.
+	if ((table->count + 1) * 2 > table->cap) {
+		if (!_VuiCtrlSibTable_resize_cap(table, table->cap ? table->cap * 2 : _VuiCtrlSibTable_init_cap))
+			return;
+	}
+	_VuiCtrlSibTable_insert_no_grow(table, parent_id, sib_id, ctrl_id);
+}
+
+//
+// removes the entry if it maps to ctrl_id.
+// uses backward shift deletion so we never need tombstones.
+void _VuiCtrlSibTable_remove(_VuiCtrlSibTable* table, VuiCtrlId parent_id, VuiCtrlSibId sib_id, VuiCtrlId ctrl_id) {
+	if (table->count == 0) return;
+	uint32_t mask = table->cap - 1;
+	uint32_t idx = _VuiCtrlSibTable_hash(parent_id, sib_id) & mask;
+	while (1) {
+		_VuiCtrlSibEntry* entry = &table->entries[idx];
+		if (entry->ctrl_id == 0) return;
+		if (entry->parent_id == parent_id && entry->sib_id == sib_id) break;
+		idx = (idx + 1) & mask;
+	}
+	if (table->entries[idx].ctrl_id != ctrl_id) return;
+
+	//
+	// shift any following entries back into the hole if their home slot
+	// is at or before the hole. stop when we reach an empty slot.
+	uint32_t hole_idx = idx;
+	uint32_t next_idx = idx;
+	while (1) {
+		next_idx = (next_idx + 1) & mask;
+		_VuiCtrlSibEntry* next = &table->entries[next_idx];
+		if (next->ctrl_id == 0) break;
+
+		uint32_t home_idx = _VuiCtrlSibTable_hash(next->parent_id, next->sib_id) & mask;
+		if (((next_idx - home_idx) & mask) >= ((next_idx - hole_idx) & mask)) {
+			table->entries[hole_idx] = *next;
+			hole_idx = next_idx;
+		}
+	}
+
+	table->entries[hole_idx] = (_VuiCtrlSibEntry){0};
+	table->count -= 1;
+}
+
 
 // ===========================================================================================
 //
@@ -778,6 +1114,10 @@ VuiBool VuiRect_intersects(const VuiRect* a, const VuiRect* b) {
         b->left_top.y < a->right_bottom.y;
 }
 
+VuiRect VuiRect_union(const VuiRect* a, const VuiRect* b) {
+	return VuiRect_init_v2(VuiVec2_min(a->left_top, b->left_top), VuiVec2_max(a->right_bottom, b->right_bottom));
+}
+
 VuiBool VuiRect_intersects_pt(const VuiRect* r, VuiVec2 pt) {
 	return r->left_top.x <= pt.x && r->right_bottom.x >= pt.x &&
 		r->left_top.y <= pt.y && r->right_bottom.y >= pt.y;
@@ -1547,19 +1887,122 @@ VuiStyleSheet vui_ss = {
 //
 // ===========================================================================================
 
+//
+// clamps the point to the clip rectangle, unless the backend clips with the rectangle in the render commands.
+static inline VuiVec2 _vui_render_clip_pt(VuiVec2 pt) {
+	if (_vui.flags & _VuiFlags_scissor_clipping)
+		return pt;
+	return VuiRect_clip_pt(&_vui_render.clip_rect, pt);
+}
+
 void vui_render_line(VuiVec2 start_pos, VuiVec2 end_pos, VuiColor color, float width) {
 	vui_path_plot_point(start_pos);
 	vui_path_plot_point(end_pos);
 	vui_render_path_stroked(color, width, vui_false);
 }
 
+#if VUI_SDF_SHAPES
+//
+// renders a rounded rectangle as one quad, the fragment shader works out the coverage from the vertices.
+// a border_width of 0 fills the shape, otherwise the border is on the inside of the rectangle.
+void _vui_render_sdf_quad(const VuiRect* rect, VuiColor color, float radius, float border_width) {
+	VuiVec2 half_size = VuiVec2_mul_scalar(VuiRect_size(*rect), 0.5f);
+	if (half_size.x <= 0.f || half_size.y <= 0.f)
+		return;
+
+	VuiVec2 center = VuiVec2_add(rect->left_top, half_size);
+	radius = vui_clamp(radius, 0.f, vui_min(half_size.x, half_size.y));
+
+	VuiRect quad = VuiRect_init(
+		rect->left - vui_sdf_aa_width, rect->top - vui_sdf_aa_width,
+		rect->right + vui_sdf_aa_width, rect->bottom + vui_sdf_aa_width);
+	if (!VuiRect_intersects(&quad, &_vui_render.clip_rect))
+		return;
+
+	VuiRenderWriter w = vui_render_get_writer(0, 4, 6);
+	vui_ensure_alloc_ok(w.verts);
+
+	w.verts[0] = VuiVertex_init_sdf(_vui_render_clip_pt(quad.left_top), color, center, half_size, radius, border_width);
+	w.verts[1] = VuiVertex_init_sdf(_vui_render_clip_pt(VuiRect_right_top(quad)), color, center, half_size, radius, border_width);
+	w.verts[2] = VuiVertex_init_sdf(_vui_render_clip_pt(quad.right_bottom), color, center, half_size, radius, border_width);
+	w.verts[3] = VuiVertex_init_sdf(_vui_render_clip_pt(VuiRect_left_bottom(quad)), color, center, half_size, radius, border_width);
+
+	w.indices[0] = w.verts_start_idx;
+	w.indices[1] = w.verts_start_idx + 1;
+	w.indices[2] = w.verts_start_idx + 2;
+	w.indices[3] = w.verts_start_idx + 2;
+	w.indices[4] = w.verts_start_idx + 3;
+	w.indices[5] = w.verts_start_idx;
+}
+#endif // VUI_SDF_SHAPES
+
+//
+// gets the command that the next verts_count vertices with this texture go in, starting a new one if needed.
+static VuiRenderCmd* _vui_render_get_cmd(VuiTextureId texture_id, uint32_t verts_count) {
+	_VuiWindow* window = _vui_render.w;
+	VuiRenderLayer* layer = &window->render_layers[_vui_render.layer_idx];
+
+	//
+	// when clipping with scissor rectangles, the vertices are not clamped to the clip rectangle.
+	// otherwise they are, so the whole window is used and commands are not split up by the clipping.
+	VuiRect clip_rect = (_vui.flags & _VuiFlags_scissor_clipping)
+		? _vui_render.clip_rect
+		: VuiRect_init_v2(VuiVec2_zero, window->size);
+
+	vui_assert(verts_count == 0 || verts_count - 1 <= _vui_vertex_idx_max, "'%u' vertices cannot be addressed by a VuiVertexIdx", verts_count);
+
+	//
+	// the commands share the verts_base_idx of the one before them, unless the new vertices
+	// cannot be addressed from there. then a new command is started from the first new vertex.
+	VuiRenderCmd* cmd = VuiStk_count(layer->cmds) == 0 ? NULL : &VuiStk_last(layer->cmds);
+	uint32_t verts_base_idx = cmd ? cmd->verts_base_idx : 0;
+	VuiBool is_idx_full = (uint64_t)VuiStk_count(layer->verts) + verts_count - verts_base_idx > _vui_vertex_idx_max + 1;
+	if (is_idx_full) {
+		verts_base_idx = VuiStk_count(layer->verts);
+	}
+
+	//
+	// here we create a new command if any of these are true:
+	// - there are no commands in the layer
+	// - the texture_id does not match
+	// - the clip_rect does not match
+	// - the vertices cannot be addressed from the command's verts_base_idx
+	//
+	if (!cmd || is_idx_full || cmd->texture_id != texture_id || memcmp(&cmd->clip_rect, &clip_rect, sizeof(VuiRect)) != 0) {
+		cmd = VuiStk_push(&layer->cmds);
+		vui_ensure_alloc_ok(cmd, NULL);
+		cmd->texture_id = texture_id;
+		cmd->clip_rect = clip_rect;
+		cmd->verts_base_idx = verts_base_idx;
+		cmd->verts_start_idx = VuiStk_count(layer->verts);
+		cmd->indices_start_idx = VuiStk_count(layer->indices);
+		cmd->indices_count = 0;
+	}
+
+	return cmd;
+}
+
 void vui_render_rect(const VuiRect* rect, VuiColor color, float radius) {
+#if VUI_SDF_SHAPES
+	//
+	// a square rectangle is only 4 vertices anyway, so only round ones are worth the more expensive fragment shader.
+	if (radius > 0.f) {
+		_vui_render_sdf_quad(rect, color, radius, 0.f);
+		return;
+	}
+#endif
 	vui_path_plot_rect(rect, radius);
 	vui_render_path_filled_convex(color);
 }
 
 void vui_render_rect_border(const VuiRect* rect, VuiColor color, float radius, float width) {
 	float half_width = width * 0.5;
+#if VUI_SDF_SHAPES
+	//
+	// the stroked path below is centered on a rectangle inset by half the width, with the radius at its center.
+	// so the outer edge of the border is rounded by the radius plus half the width.
+	_vui_render_sdf_quad(rect, color, radius > 0.f ? radius + half_width : 0.f, width);
+#else
 	VuiRect border_rect;
 	border_rect.left = rect->left + half_width;
 	border_rect.top = rect->top + half_width;
@@ -1567,6 +2010,7 @@ void vui_render_rect_border(const VuiRect* rect, VuiColor color, float radius, f
 	border_rect.right = rect->right - half_width;
 	vui_path_plot_rect(&border_rect, radius);
 	vui_render_path_stroked(color, width, vui_true);
+#endif
 }
 
 void vui_render_triangle(VuiVec2 a, VuiVec2 b, VuiVec2 c, VuiColor color) {
@@ -1584,23 +2028,35 @@ void vui_render_triangle_border(VuiVec2 a, VuiVec2 b, VuiVec2 c, VuiColor color,
 }
 
 void vui_render_circle(VuiVec2 pos, float radius, VuiColor color) {
+#if VUI_SDF_SHAPES
+	VuiRect rect = VuiRect_init(pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius);
+	_vui_render_sdf_quad(&rect, color, radius, 0.f);
+#else
 	vui_path_plot_circle(pos, radius, vui_false);
 	vui_render_path_filled_convex(color);
+#endif
 }
 
 void vui_render_circle_border(VuiVec2 pos, float radius, VuiColor color, float width) {
+#if VUI_SDF_SHAPES
+	//
+	// the border is centered on the radius.
+	float outer_radius = radius + width * 0.5f;
+	VuiRect rect = VuiRect_init(pos.x - outer_radius, pos.y - outer_radius, pos.x + outer_radius, pos.y + outer_radius);
+	_vui_render_sdf_quad(&rect, color, outer_radius, width);
+#else
 	vui_path_plot_circle(pos, radius, vui_true);
 	vui_render_path_stroked(color, width, vui_true);
+#endif
 }
 
-static VuiColor _vui_render_glyph_color = {0};
 void _vui_render_glyph(const VuiRect* rect, VuiTextureId glyph_texture_id, const VuiRect* uv_rect) {
-	vui_render_image_(rect, 0.f, 0.f, glyph_texture_id, *uv_rect, _vui_render_glyph_color, VuiImageScaleMode_stretch, vui_true, 1.0);
+	vui_render_image_(rect, 0.f, 0.f, glyph_texture_id, *uv_rect, _vui_render.glyph_color, VuiImageScaleMode_stretch, vui_true, 1.0);
 }
 
 void vui_render_text(VuiVec2 left_top, VuiFontId font_id, float line_height, char* text, uint32_t text_length, VuiColor color, float word_wrap_at_width) {
 	if (text_length) {
-		_vui_render_glyph_color = color;
+		_vui_render.glyph_color = color;
 		VuiPositionTextArgs args = {0};
 		args.userdata = _vui.position_text_userdata;
 		args.font_id = font_id;
@@ -1624,12 +2080,33 @@ void vui_render_polyline(VuiVec2* points, uint32_t points_count, VuiColor color,
 
 	float half_width = width / 2.f;
 
+	//
+	// the corner pieces index the vertices of the lines either side of them, so they must be in the same command.
+	// each line has 4 vertices and each corner piece has 2, the first one has 3.
+	// when the polyline has more vertices than a VuiVertexIdx can address, it is split over many commands,
+	// and each one after the first starts with a copy of the vertices of the line before it for the corner piece to use.
+	uint64_t max_lines_per_cmd = (_vui_vertex_idx_max + 1 - 5) / 6;
+	uint32_t lines_per_cmd = points_end < max_lines_per_cmd ? points_end : (uint32_t)max_lines_per_cmd;
+
 	VuiVec2 start = points[0];
 	VuiVec2 prev_vec = VuiVec2_zero;
 	VuiVec2 rect_points[4];
 	for (uint32_t idx = 0; idx < points_end; idx += 1) {
 		VuiVec2 end = points[idx == points_count - 1 ? 0 : idx + 1];
 
+		if (idx % lines_per_cmd == 0) {
+			uint32_t lines_count = points_end - idx < lines_per_cmd ? points_end - idx : lines_per_cmd;
+			if (!_vui_render_get_cmd(0, lines_count * 6 + 5)) return;
+
+			if (idx > 0) {
+				VuiRenderWriter w = vui_render_get_writer(0, 4, 0);
+				vui_ensure_alloc_ok(w.verts);
+				for (uint32_t rect_idx = 0; rect_idx < 4; rect_idx += 1) {
+					w.verts[rect_idx] = VuiVertex_init(_vui_render_clip_pt(rect_points[rect_idx]), VuiVec2_zero, color);
+				}
+			}
+		}
+
 		//
 		// get the direction vector of the line.
 		// then get both perpendicular offset vectors.
@@ -1688,8 +2165,13 @@ void vui_render_polyline(VuiVec2* points, uint32_t points_count, VuiColor color,
 				middle_vec = VuiVec2_norm(middle_vec);
 			}
 
-			VuiRenderLayer* layer = &_vui.render.w->render_layers[_vui.render.layer_idx];
-			uint32_t vertices_count = VuiStk_count(layer->verts);
+			VuiRenderLayer* layer = &_vui_render.w->render_layers[_vui_render.layer_idx];
+			uint32_t vertices_count = VuiStk_count(layer->verts) - VuiStk_last(layer->cmds).verts_base_idx;
+
+			//
+			// if connect_first_and_last and on the first line, the last line has not been made yet.
+			// so the corner piece makes its own copy of the vertex it needs from it.
+			uint32_t corner_verts_count = idx == 0 ? 3 : 2;
 
 			//
 			// multiply cross to see which side of the line to place the corner piece
@@ -1704,22 +2186,16 @@ void vui_render_polyline(VuiVec2* points, uint32_t points_count, VuiColor color,
 				// reuse the vertex made with rect_points[1] from the previous line
 				v1_idx_from_prev_line = vertices_count - 3;
 
-				// reuse the vertex made with rect_points[0] from the next line (add an extra 2 here is to skip over the two new vertices below)
-				v3_idx_from_next_line = vertices_count + 2;
+				// reuse the vertex made with rect_points[0] from the next line (skip over the new vertices of the corner piece below)
+				v3_idx_from_next_line = vertices_count + corner_verts_count;
 			} else {
 				v1_dir = VuiVec2_perp_right(prev_vec);
 
 				// reuse the vertex made with rect_points[2] from the previous line
 				v1_idx_from_prev_line = vertices_count - 2;
 
-				// reuse the vertex made with rect_points[3] from the next line (add an extra 2 here is to skip over the two new vertices below)
-				v3_idx_from_next_line = vertices_count + 5;
-			}
-
-			if (idx == 0) {
-				// if connect_first_and_last and on the first line.
-				// then move the v1_idx_from_prev_line to point to the last line that will be main in the future.
-				v1_idx_from_prev_line += points_count * 4 + (points_count - 1) * 2;
+				// reuse the vertex made with rect_points[3] from the next line (skip over the new vertices of the corner piece below)
+				v3_idx_from_next_line = vertices_count + corner_verts_count + 3;
 			}
 
 			//
@@ -1728,15 +2204,20 @@ void vui_render_polyline(VuiVec2* points, uint32_t points_count, VuiColor color,
 
 			//
 			// now create the two new vertices; one the extend middle point and the other for where the two lines meet.
-			VuiRenderWriter w = vui_render_get_writer(0, 2, 6);
+			VuiRenderWriter w = vui_render_get_writer(0, corner_verts_count, 6);
 			vui_ensure_alloc_ok(w.verts);
 
-			w.verts[0] = (VuiVertex) {
-				.pos = VuiRect_clip_pt(&_vui.render.clip_rect, VuiVec2_add(start, VuiVec2_mul_scalar(middle_vec, half_width + half_width * (1.0 - d)))),
-				.uv = VuiVec2_zero,
-				.color = color
-			};
-			w.verts[1] = (VuiVertex) { .pos = VuiRect_clip_pt(&_vui.render.clip_rect, start), .uv = VuiVec2_zero, .color = color };
+			w.verts[0] = VuiVertex_init(
+				_vui_render_clip_pt(VuiVec2_add(start, VuiVec2_mul_scalar(middle_vec, half_width + half_width * (1.0 - d)))),
+				VuiVec2_zero,
+				color);
+			w.verts[1] = VuiVertex_init(_vui_render_clip_pt(start), VuiVec2_zero, color);
+			if (idx == 0) {
+				//
+				// this is where rect_points[1] or rect_points[2] of the last line will be.
+				w.verts[2] = VuiVertex_init(_vui_render_clip_pt(VuiVec2_add(start, VuiVec2_mul_scalar(v1_dir, half_width))), VuiVec2_zero, color);
+				v1_idx_from_prev_line = w.verts_start_idx + 2;
+			}
 
 			//
 			// now create the indices that for the corner piece quad.
@@ -1775,7 +2256,7 @@ void vui_render_convex_polygon(VuiVec2* points, uint32_t points_count, VuiColor
 
 	for (uint32_t idx = 0; idx < points_count; idx += 1) {
 		VuiVertex* vert = &w.verts[idx];
-		*vert = VuiVertex_init(VuiRect_clip_pt(&_vui.render.clip_rect, points[idx]), VuiVec2_zero, color);
+		*vert = VuiVertex_init(_vui_render_clip_pt(points[idx]), VuiVec2_zero, color);
 	}
 
 
@@ -1809,13 +2290,10 @@ void vui_render_bezier_curve(VuiVec2 points[4], VuiColor color, float width) {
 
 void vui_render_image(const VuiRect* rect, VuiImageId image_id, VuiColor image_tint, VuiImageScaleMode scale_mode, float scale) {
 	VuiImage* image = vui_image_get(image_id);
-	vui_render_image_(rect, image->width, image->height, image->texture_id, image->uv_rect, image_tint, scale_mode, vui_false, scale);
+	vui_render_image_(rect, image->width, image->height, image->texture_id, image->uv_rect, image_tint, scale_mode, image->is_alpha_mask, scale);
 }
 
 void vui_render_image_(const VuiRect* rect_ptr, float image_width, float image_height, VuiTextureId texture_id, VuiRect uv_rect, VuiColor color, VuiImageScaleMode scale_mode, VuiBool is_glyph, float scale) {
-	VuiRenderWriter w = vui_render_get_writer(texture_id, 4, 6);
-	vui_ensure_alloc_ok(w.verts);
-
 	VuiRect rect = *rect_ptr;
 	switch (scale_mode) {
 		case VuiImageScaleMode_stretch: {
@@ -1872,8 +2350,18 @@ void vui_render_image_(const VuiRect* rect_ptr, float image_width, float image_h
 		rect.bottom += diff_y;
 	}
 
-	VuiRect clipped_rect = VuiRect_clip(&rect, &_vui.render.clip_rect);
-	{
+	//
+	// nothing to draw if it is completely clipped, this happens a lot with long text.
+	if (!VuiRect_intersects(&rect, &_vui_render.clip_rect))
+		return;
+
+	VuiRenderWriter w = vui_render_get_writer(texture_id, 4, 6);
+	vui_ensure_alloc_ok(w.verts);
+
+	VuiRect clipped_rect = rect;
+	if (!(_vui.flags & _VuiFlags_scissor_clipping)) {
+		clipped_rect = VuiRect_clip(&rect, &_vui_render.clip_rect);
+
 		//
 		// clip the side of the uv coordiates by the same ratio the rectangle got clipped
 		float width = rect.right_bottom.x - rect.left_top.x;
@@ -1901,26 +2389,27 @@ void vui_render_image_(const VuiRect* rect_ptr, float image_width, float image_h
 		if (diff > 0.0) uv_rect.right_bottom.y -= diff * h_ratio;
 	}
 
-	if (is_glyph) {
-		uv_rect.left_top.x = -uv_rect.left_top.x;
-		uv_rect.left_top.y = -uv_rect.left_top.y;
-		uv_rect.right_bottom.x = -uv_rect.right_bottom.x;
-		uv_rect.right_bottom.y = -uv_rect.right_bottom.y;
-	}
-
-	w.verts[0] = VuiVertex_init(clipped_rect.left_top, uv_rect.left_top, color);
-
-	w.verts[1] = VuiVertex_init(
+	VuiVec2 positions[4] = {
+		clipped_rect.left_top,
 		VuiVec2_init(clipped_rect.right_bottom.x, clipped_rect.left_top.y),
-		VuiVec2_init(uv_rect.right_bottom.x, uv_rect.left_top.y),
-		color);
-
-	w.verts[2] = VuiVertex_init(clipped_rect.right_bottom, uv_rect.right_bottom, color);
-
-	w.verts[3] = VuiVertex_init(
+		clipped_rect.right_bottom,
 		VuiVec2_init(clipped_rect.left_top.x, clipped_rect.right_bottom.y),
+	};
+
+	VuiVec2 uvs[4] = {
+		uv_rect.left_top,
+		VuiVec2_init(uv_rect.right_bottom.x, uv_rect.left_top.y),
+		uv_rect.right_bottom,
 		VuiVec2_init(uv_rect.left_top.x, uv_rect.right_bottom.y),
-		color);
+	};
+
+	//
+	// the vertex marks the glyphs, see VuiVertex_init_glyph.
+	for (uint32_t idx = 0; idx < 4; idx += 1) {
+		w.verts[idx] = is_glyph
+			? VuiVertex_init_glyph(positions[idx], uvs[idx], color)
+			: VuiVertex_init(positions[idx], uvs[idx], color);
+	}
 
 	w.indices[0] = w.verts_start_idx;
 	w.indices[1] = w.verts_start_idx + 1;
@@ -1931,20 +2420,99 @@ void vui_render_image_(const VuiRect* rect_ptr, float image_width, float image_h
 }
 
 void vui_path_reset() {
-	VuiStk_clear(_vui.render.path_points);
+	VuiStk_clear(_vui_render.path_points);
 }
 
 void vui_path_plot_point(VuiVec2 pt) {
-	VuiVec2* t = VuiStk_push(&_vui.render.path_points);
+	VuiVec2* t = VuiStk_push(&_vui_render.path_points);
 	vui_ensure_alloc_ok(t);
 	*t = pt;
 }
 
+//
+// returns a table of unit circle points for an arc with points_count points.
+// the table holds a full turn of points_count * 4 steps (plus the closing point),
+// so an arc that starts and ends on a quarter turn is a strided walk through the table.
+// the tables are built lazily and live for the rest of the program.
+static VuiVec2* _vui_unit_arc_get(uint32_t points_count) {
+	if (points_count > _vui_unit_arc_points_max) return NULL;
+
+	uint32_t count = VuiStk_count(_vui_render.unit_arcs);
+	if (points_count >= count) {
+		VuiVec2** new_tables = VuiStk_push_many(&_vui_render.unit_arcs, points_count + 1 - count);
+		if (!new_tables) return NULL;
+		memset(new_tables, 0, (points_count + 1 - count) * sizeof(VuiVec2*));
+	}
+
+	VuiVec2* table = _vui_render.unit_arcs[points_count];
+	if (table) return table;
+
+	uint32_t turn = points_count * 4;
+	table = vui_mem_alloc_array(VuiVec2, _vui.allocator, turn + 1);
+	if (!table) return NULL;
+
+	double angle_step = (M_PI / 2.0) / points_count;
+	for (uint32_t idx = 0; idx <= turn; idx += 1) {
+		double angle = angle_step * idx;
+		table[idx] = VuiVec2_init(cos(angle), -sin(angle));
+	}
+
+	_vui_render.unit_arcs[points_count] = table;
+	return table;
+}
+
 void vui_path_plot_arc(VuiVec2 pt, float radius, float angle_start, float angle_end, uint32_t segments_count) {
 	uint32_t points_count = segments_count + 1;
-	VuiVec2* points = VuiStk_push_many(&_vui.render.path_points, points_count);
+	VuiVec2* points = VuiStk_push_many(&_vui_render.path_points, points_count);
 	vui_ensure_alloc_ok(points);
 
+	//
+	// the step between each point is (angle_end - angle_start) / points_count.
+	// so when the start and the length of the arc are whole quarter turns,
+	// each point lands on an entry in the unit arc table for this points count.
+	float quarter = M_PI / 2.f;
+	float start_quarters = roundf(angle_start / quarter);
+	float length_quarters = roundf((angle_end - angle_start) / quarter);
+	VuiVec2* table = NULL;
+	if (
+		fabsf(angle_start - start_quarters * quarter) < 0.0001f &&
+		fabsf((angle_end - angle_start) - length_quarters * quarter) < 0.0001f &&
+		fabsf(length_quarters) <= 4.f
+	) {
+		table = _vui_unit_arc_get(points_count);
+	}
+
+	if (table) {
+		int32_t turn = points_count * 4;
+		int32_t stride = (int32_t)length_quarters;
+		int32_t idx = ((int32_t)start_quarters % 4) * points_count;
+		if (idx < 0) idx += turn;
+		// start from the end of the table when going backwards from 0, as it is the same point.
+		if (idx == 0 && stride < 0) idx = turn;
+		int32_t last_idx = idx + stride * (int32_t)segments_count;
+
+		if (last_idx >= 0 && last_idx <= turn) {
+			//
+			// the whole arc is in the table without wrapping around, which is the case for
+			// the rounded rectangle corners and circles. keep this loop simple so it vectorizes.
+			const VuiVec2* src = &table[idx];
+			for (int32_t i = 0; i < (int32_t)points_count; i += 1) {
+				VuiVec2 unit = src[i * stride];
+				points[i].x = pt.x + unit.x * radius;
+				points[i].y = pt.y + unit.y * radius;
+			}
+		} else {
+			for (uint32_t i = 0; i < points_count; i += 1) {
+				VuiVec2 unit = table[idx];
+				points[i] = VuiVec2_init(pt.x + unit.x * radius, pt.y + unit.y * radius);
+				idx += stride;
+				if (idx < 0) idx += turn;
+				else if (idx > turn) idx -= turn;
+			}
+		}
+		return;
+	}
+
 	float angle_step = (angle_end - angle_start) / points_count;
 	float angle = angle_start;
 	for (uint32_t idx = 0; idx < points_count; idx += 1) {
@@ -1960,7 +2528,12 @@ void vui_path_plot_bezier_curve(VuiVec2 start_control_pt, VuiVec2 end_control_pt
 uint32_t vui_calc_circle_segments_count(float radius) {
 	uint32_t min = 12;
 	uint32_t max = 512;
-	return vui_clamp((uint32_t)(M_PI * 2.0f / acosf((radius - max) / radius)), min, max);
+	//
+	// acosf is only defined between -1 and 1, so radii below half of the max always get the min.
+	// this is the common case, so it skips the acosf altogether.
+	float x = (radius - max) / radius;
+	if (!(x > -1.f)) return min;
+	return vui_clamp((uint32_t)(M_PI * 2.0f / acosf(x)), min, max);
 }
 
 void vui_path_plot_rect(const VuiRect* rect, float radius) {
@@ -1995,38 +2568,24 @@ void vui_path_plot_circle(VuiVec2 pt, float radius, VuiBool is_border) {
 }
 
 void vui_render_path_stroked(VuiColor color, float width, VuiBool connect_first_and_last) {
-	vui_render_polyline(_vui.render.path_points, VuiStk_count(_vui.render.path_points), color, width, connect_first_and_last);
+	vui_render_polyline(_vui_render.path_points, VuiStk_count(_vui_render.path_points), color, width, connect_first_and_last);
 	vui_path_reset();
 }
 
 void vui_render_path_filled_convex(VuiColor color) {
-	vui_render_convex_polygon(_vui.render.path_points, VuiStk_count(_vui.render.path_points), color);
+	vui_render_convex_polygon(_vui_render.path_points, VuiStk_count(_vui_render.path_points), color);
 	vui_path_reset();
 }
 
 VuiRenderWriter vui_render_get_writer(VuiTextureId texture_id, uint32_t verts_count, uint32_t indices_count) {
-	_VuiWindow* window = _vui.render.w;
-	VuiRenderLayer* layer = &window->render_layers[_vui.render.layer_idx];
-
-	//
-	// here we create a new command if any of these are true:
-	// - there are no commands in the layer
-	// - the texture_id does not match
-	//
-	VuiRenderCmd* cmd = VuiStk_count(layer->cmds) == 0 ? NULL : &VuiStk_last(layer->cmds);
-	if (!cmd || cmd->texture_id != texture_id) {
-		cmd = VuiStk_push(&layer->cmds);
-		vui_ensure_alloc_ok(cmd, (VuiRenderWriter){0});
-		cmd->texture_id = texture_id;
-		cmd->verts_start_idx = VuiStk_count(layer->verts);
-		cmd->indices_start_idx = VuiStk_count(layer->indices);
-		cmd->indices_count = 0;
-	}
+	VuiRenderLayer* layer = &_vui_render.w->render_layers[_vui_render.layer_idx];
+	VuiRenderCmd* cmd = _vui_render_get_cmd(texture_id, verts_count);
+	if (!cmd) return (VuiRenderWriter){0};
 
 	cmd->indices_count += indices_count;
 
 	VuiRenderWriter w = {0};
-	w.verts_start_idx = VuiStk_count(layer->verts);
+	w.verts_start_idx = VuiStk_count(layer->verts) - cmd->verts_base_idx;
 	w.verts = VuiStk_push_many(&layer->verts, verts_count);
 	vui_ensure_alloc_ok(w.verts, (VuiRenderWriter){0});
 	w.indices = VuiStk_push_many(&layer->indices, indices_count);
@@ -2035,9 +2594,9 @@ VuiRenderWriter vui_render_get_writer(VuiTextureId texture_id, uint32_t verts_co
 }
 
 void vui_render_inc_layer() {
-	_vui.render.layer_idx += 1;
-	_VuiWindow* window = _vui.render.w;
-	if (_vui.render.layer_idx == VuiStk_count(window->render_layers)) {
+	_vui_render.layer_idx += 1;
+	_VuiWindow* window = _vui_render.w;
+	if (_vui_render.layer_idx == VuiStk_count(window->render_layers)) {
 		VuiRenderLayer* layer = VuiStk_push(&window->render_layers);
 		vui_ensure_alloc_ok(layer);
 		*layer = (VuiRenderLayer){0};
@@ -2045,8 +2604,8 @@ void vui_render_inc_layer() {
 }
 
 void vui_render_dec_layer() {
-	vui_assert(_vui.render.layer_idx > 0, "cannot decrement layer when we are already on layer 0");
-	_vui.render.layer_idx -= 1;
+	vui_assert(_vui_render.layer_idx > 0, "cannot decrement layer when we are already on layer 0");
+	_vui_render.layer_idx -= 1;
 }
 
 // ====================================================================================
@@ -2099,21 +2658,170 @@ uint64_t vui_fnv_hash_64(char* bytes, uint32_t byte_count, uint64_t hash) {
 	return hash;
 }
 
-#define _VuiCtrlId_pool_id_MASK  0x000fffff
-#define _VuiCtrlId_pool_id_SHIFT 0
-#define _VuiCtrlId_counter_MASK  0xfff00000
-#define _VuiCtrlId_counter_SHIFT 20
+//
+// like vui_fnv_hash_64 but consumes 8 bytes at a time.
+// used for the large vertex arrays that are hashed every frame.
+uint64_t _vui_hash_64_words(char* bytes, uint32_t byte_count, uint64_t hash) {
+	char* bytes_end = bytes + (byte_count & ~7);
+	while (bytes < bytes_end) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash = (hash ^ word) * 0x00000100000001B3;
+		hash ^= hash >> 32;
+		bytes += 8;
+	}
+	return vui_fnv_hash_64(bytes, byte_count & 7, hash);
+}
+
+//
+// a hash for large arrays, built like XXH64. 32 bytes are consumed at a time across four
+// independent 64 bit lanes, so the multiplies do not depend on each other like they do in FNV.
+// it only depends on the bytes and the seed, so it is the same across runs.
+#define _vui_hash_prime_1 0x9E3779B185EBCA87ULL
+#define _vui_hash_prime_2 0xC2B2AE3D27D4EB4FULL
+#define _vui_hash_prime_3 0x165667B19E3779F9ULL
+#define _vui_hash_prime_4 0x85EBCA77C2B2AE63ULL
+#define _vui_hash_prime_5 0x27D4EB2F165667C5ULL
+#define _vui_hash_rotl(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static inline uint64_t _vui_hash_round(uint64_t acc, uint64_t word) {
+	acc += word * _vui_hash_prime_2;
+	acc = _vui_hash_rotl(acc, 31);
+	return acc * _vui_hash_prime_1;
+}
+
+static inline uint64_t _vui_hash_merge_round(uint64_t hash, uint64_t acc) {
+	hash ^= _vui_hash_round(0, acc);
+	return hash * _vui_hash_prime_1 + _vui_hash_prime_4;
+}
+
+uint64_t _vui_hash_64_lanes(char* bytes, uintptr_t byte_count, uint64_t seed) {
+	char* bytes_end = bytes + byte_count;
+	uint64_t hash;
+	if (byte_count >= 32) {
+		uint64_t acc[4] = {
+			seed + _vui_hash_prime_1 + _vui_hash_prime_2,
+			seed + _vui_hash_prime_2,
+			seed,
+			seed - _vui_hash_prime_1,
+		};
+		char* lanes_end = bytes + (byte_count & ~(uintptr_t)31);
+		while (bytes < lanes_end) {
+			uint64_t words[4];
+			memcpy(words, bytes, sizeof(words));
+			acc[0] = _vui_hash_round(acc[0], words[0]);
+			acc[1] = _vui_hash_round(acc[1], words[1]);
+			acc[2] = _vui_hash_round(acc[2], words[2]);
+			acc[3] = _vui_hash_round(acc[3], words[3]);
+			bytes += 32;
+		}
+		hash = _vui_hash_rotl(acc[0], 1) + _vui_hash_rotl(acc[1], 7) + _vui_hash_rotl(acc[2], 12) + _vui_hash_rotl(acc[3], 18);
+		hash = _vui_hash_merge_round(hash, acc[0]);
+		hash = _vui_hash_merge_round(hash, acc[1]);
+		hash = _vui_hash_merge_round(hash, acc[2]);
+		hash = _vui_hash_merge_round(hash, acc[3]);
+	} else {
+		hash = seed + _vui_hash_prime_5;
+	}
+	hash += (uint64_t)byte_count;
+
+	while (bytes + 8 <= bytes_end) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash ^= _vui_hash_round(0, word);
+		hash = _vui_hash_rotl(hash, 27) * _vui_hash_prime_1 + _vui_hash_prime_4;
+		bytes += 8;
+	}
+	if (bytes + 4 <= bytes_end) {
+		uint32_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash ^= (uint64_t)word * _vui_hash_prime_1;
+		hash = _vui_hash_rotl(hash, 23) * _vui_hash_prime_2 + _vui_hash_prime_3;
+		bytes += 4;
+	}
+	while (bytes < bytes_end) {
+		hash ^= (uint8_t)*bytes * _vui_hash_prime_5;
+		hash = _vui_hash_rotl(hash, 11) * _vui_hash_prime_1;
+		bytes += 1;
+	}
+
+	//
+	// mix the bits so every input bit affects every output bit.
+	hash ^= hash >> 33;
+	hash *= _vui_hash_prime_2;
+	hash ^= hash >> 29;
+	hash *= _vui_hash_prime_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+static inline void _vui_build_hash(void* data, uint32_t size) {
+	_vui.build.hash = _vui_hash_64_words(data, size, _vui.build.hash);
+}
+
+#define _VuiCtrlId_pool_id_MASK  0x000fffff
+#define _VuiCtrlId_pool_id_SHIFT 0
+#define _VuiCtrlId_counter_MASK  0xfff00000
+#define _VuiCtrlId_counter_SHIFT 20
+
+_VuiCache* _vui_cache_get(VuiCtrl* ctrl) {
+	return _VuiPool_id_to_ptr((_VuiPool*)&_vui.cache_pool, ctrl->cache_id, sizeof(_VuiCache));
+}
+
+void _vui_cache_dealloc(VuiCtrl* ctrl) {
+	_VuiCache* cache = _vui_cache_get(ctrl);
+	VuiStk_deinit(cache->text);
+	VuiStk_deinit(cache->render_cmds);
+	VuiStk_deinit(cache->render_verts);
+	VuiStk_deinit(cache->render_indices);
+	_VuiPool_dealloc((_VuiPool*)&_vui.cache_pool, ctrl->cache_id);
+	ctrl->cache_id = 0;
+}
 
 VuiCtrl* _vui_ctrl_alloc(VuiCtrlId* id_out) {
 	VuiPoolId pool_id = 0;
 	_VuiCtrl* ctrl = _VuiPool_alloc((_VuiPool*)&_vui.ctrl_pool, &pool_id, sizeof(_VuiCtrl), alignof(_VuiCtrl));
 	memset(&ctrl->inner, 0, sizeof(VuiCtrl));
+
+	if (_vui.ctrl_colds_cap < _vui.ctrl_pool.cap) {
+		VuiCtrlCold* colds = vui_mem_realloc_array(VuiCtrlCold, _vui.allocator, _vui.ctrl_colds, _vui.ctrl_colds_cap, _vui.ctrl_pool.cap);
+		vui_assert(colds, "failed to allocate memory for the controls");
+		_vui.ctrl_colds = colds;
+		_vui.ctrl_colds_cap = _vui.ctrl_pool.cap;
+	}
+	memset(&_vui.ctrl_colds[pool_id - 1], 0, sizeof(VuiCtrlCold));
+
 	VuiCtrlId ctrl_id = (pool_id << _VuiCtrlId_pool_id_SHIFT) & _VuiCtrlId_pool_id_MASK;
 	ctrl_id |= (ctrl->counter << _VuiCtrlId_counter_SHIFT) & _VuiCtrlId_counter_MASK;
 	*id_out = ctrl_id;
 	return &ctrl->inner;
 }
 
+//
+// deallocates the control without checking if it has any of the focuses.
+void _vui_ctrl_dealloc_unfocused(VuiCtrlId ctrl_id) {
+	vui_assert(ctrl_id, "cannot remove an ctrl with a NULL identifier");
+	VuiPoolId pool_id = (ctrl_id & _VuiCtrlId_pool_id_MASK) >> _VuiCtrlId_pool_id_SHIFT;
+	uint16_t counter = (ctrl_id & _VuiCtrlId_counter_MASK) >> _VuiCtrlId_counter_SHIFT;
+	_VuiCtrl* ctrl = _VuiPool_id_to_ptr((_VuiPool*)&_vui.ctrl_pool, pool_id, sizeof(_VuiCtrl));
+	vui_assert(ctrl->counter == counter, "trying to remove an ctrl with an old identifier");
+	if (ctrl->inner.parent_id) {
+		_VuiCtrlSibTable_remove(&_vui.ctrl_sib_table, ctrl->inner.parent_id, ctrl->inner.sib_id, ctrl_id);
+	}
+	if ((ctrl->inner.flags & _VuiCtrlFlags_is_cache) && ctrl->inner.cache_id) {
+		_vui_cache_dealloc(&ctrl->inner);
+	}
+
+	//
+	// the area the control was rendered to last frame needs to be redrawn.
+	if (ctrl->inner.render_hash && _vui.build.w) {
+		VuiRect* bounds = VuiStk_push(&_vui.build.w->removed_ctrl_bounds);
+		vui_ensure_alloc_ok(bounds);
+		*bounds = ctrl->inner.render_bounds;
+	}
+	_VuiPool_dealloc((_VuiPool*)&_vui.ctrl_pool, pool_id);
+}
+
 void _vui_ctrl_dealloc(VuiCtrlId ctrl_id) {
 	_VuiWindow* w = &_vui.windows[_vui.focused_window_id];
 	if (ctrl_id == _vui.mouse_focused_ctrl_id) {
@@ -2126,12 +2834,7 @@ void _vui_ctrl_dealloc(VuiCtrlId ctrl_id) {
 		vui_ctrl_set_focused(0);
 	}
 
-	vui_assert(ctrl_id, "cannot remove an ctrl with a NULL identifier");
-	VuiPoolId pool_id = (ctrl_id & _VuiCtrlId_pool_id_MASK) >> _VuiCtrlId_pool_id_SHIFT;
-	uint16_t counter = (ctrl_id & _VuiCtrlId_counter_MASK) >> _VuiCtrlId_counter_SHIFT;
-	_VuiCtrl* ctrl = _VuiPool_id_to_ptr((_VuiPool*)&_vui.ctrl_pool, pool_id, sizeof(_VuiCtrl));
-	vui_assert(ctrl->counter == counter, "trying to remove an ctrl with an old identifier");
-	_VuiPool_dealloc((_VuiPool*)&_vui.ctrl_pool, pool_id, sizeof(_VuiCtrl), alignof(_VuiCtrl));
+	_vui_ctrl_dealloc_unfocused(ctrl_id);
 }
 
 VuiCtrlId vui_ctrl_get_id() {
@@ -2156,6 +2859,11 @@ VuiCtrl* vui_ctrl_try_get(VuiCtrlId ctrl_id) {
 	return &ctrl->inner;
 }
 
+VuiCtrlCold* vui_ctrl_cold(VuiCtrl* ctrl) {
+	VuiPoolId pool_id = (ctrl->id & _VuiCtrlId_pool_id_MASK) >> _VuiCtrlId_pool_id_SHIFT;
+	return &_vui.ctrl_colds[pool_id - 1];
+}
+
 void _vui_ctrl_unlink(VuiCtrl* ctrl) {
 	//
 	// if we have a previous sibling then make it point to our next sibling.
@@ -2179,6 +2887,11 @@ void _vui_ctrl_unlink(VuiCtrl* ctrl) {
 		parent->child_last_id = ctrl->sibling_prev_id;
 	}
 
+	if (ctrl->parent_id) {
+		_VuiCtrlSibTable_remove(&_vui.ctrl_sib_table, ctrl->parent_id, ctrl->sib_id, ctrl->id);
+		vui_ctrl_get(ctrl->parent_id)->children_count -= 1;
+	}
+
 	ctrl->sibling_prev_id = 0;
 	ctrl->sibling_next_id = 0;
 }
@@ -2214,12 +2927,24 @@ void _vui_ctrl_insert(VuiCtrl* ctrl) {
 		}
 	}
 	ctrl->parent_id = _vui.build.parent_ctrl_id;
+	_VuiCtrlSibTable_set(&_vui.ctrl_sib_table, ctrl->parent_id, ctrl->sib_id, ctrl->id);
+	vui_ctrl_get(ctrl->parent_id)->children_count += 1;
+}
+
+static void _VuiCtrl_set_box_style(VuiCtrl* ctrl, const VuiCtrlStyle* style) {
+	ctrl->box_style.margin = style->margin;
+	ctrl->box_style.padding = style->padding;
+	ctrl->box_style.bg_color = style->bg_color;
+	ctrl->box_style.border_color = style->border_color;
+	ctrl->box_style.border_width = style->border_width;
+	ctrl->box_style.radius = style->radius;
 }
 
 void _VuiCtrl_style_interp(VuiCtrl* ctrl, float dt) {
 	if (ctrl->styles == NULL) return;
+	VuiCtrlCold* cold = vui_ctrl_cold(ctrl);
 	const VuiCtrlStyle* to = &ctrl->styles[ctrl->state];
-	const VuiCtrlStyle* from = &ctrl->prev_style;
+	const VuiCtrlStyle* from = &cold->prev_style;
 
 	float prev_state_time = ctrl->state_time;
 	ctrl->state_time += dt;
@@ -2229,7 +2954,8 @@ void _VuiCtrl_style_interp(VuiCtrl* ctrl, float dt) {
 		// state has been changed this frame and we do not have a transition time.
 		// so just copy the style we are going to.
 		//
-		ctrl->style = *to;
+		cold->style = *to;
+		_VuiCtrl_set_box_style(ctrl, to);
 		return;
 	}
 
@@ -2244,24 +2970,25 @@ void _VuiCtrl_style_interp(VuiCtrl* ctrl, float dt) {
 		interp_ratio = ctrl->state_time / ctrl->attributes.style_transition_time;
 	}
 
-	ctrl->style.font_id = to->font_id;
+	cold->style.font_id = to->font_id;
 
-	VuiThickness_lerp(&ctrl->style.margin, &to->margin, &from->margin, interp_ratio);
-	VuiThickness_lerp(&ctrl->style.padding, &to->padding, &from->padding, interp_ratio);
-	ctrl->style.bg_color = VuiColor_lerp(to->bg_color, from->bg_color, interp_ratio);
-	ctrl->style.border_color = VuiColor_lerp(to->border_color, from->border_color, interp_ratio);
-	ctrl->style.border_width = vui_lerp(to->border_width, from->border_width, interp_ratio);
-	ctrl->style.radius = vui_lerp(to->radius, from->radius, interp_ratio);
+	VuiThickness_lerp(&cold->style.margin, &to->margin, &from->margin, interp_ratio);
+	VuiThickness_lerp(&cold->style.padding, &to->padding, &from->padding, interp_ratio);
+	cold->style.bg_color = VuiColor_lerp(to->bg_color, from->bg_color, interp_ratio);
+	cold->style.border_color = VuiColor_lerp(to->border_color, from->border_color, interp_ratio);
+	cold->style.border_width = vui_lerp(to->border_width, from->border_width, interp_ratio);
+	cold->style.radius = vui_lerp(to->radius, from->radius, interp_ratio);
 
 	for (uint32_t i = 0; i < VuiCtrlStyle_max_colors; i += 1) {
-		ctrl->style.colors[i] = VuiColor_lerp(to->colors[i], from->colors[i], interp_ratio);
+		cold->style.colors[i] = VuiColor_lerp(to->colors[i], from->colors[i], interp_ratio);
 	}
 
 	for (uint32_t i = 0; i < VuiCtrlStyle_max_sizes; i += 1) {
-		ctrl->style.sizes[i] = vui_lerp(to->sizes[i], from->sizes[i], interp_ratio);
+		cold->style.sizes[i] = vui_lerp(to->sizes[i], from->sizes[i], interp_ratio);
 	}
 
-	VuiCtrlStyleUserExt_lerp(ctrl->style, to, from, interp_ratio);
+	VuiCtrlStyleUserExt_lerp(cold->style, to, from, interp_ratio);
+	_VuiCtrl_set_box_style(ctrl, &cold->style);
 }
 
 void VuiImage_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
@@ -2270,21 +2997,23 @@ void VuiImage_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
 }
 
 void VuiText_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
-	const VuiCtrlStyle* style = &ctrl->style;
-	char* text = &_vui.render.w->text[ctrl->text_start_idx];
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
+	char* text = &_vui_render.w->text[ctrl->text_start_idx];
 	vui_render_text(content_rect->left_top, style->font_id, style->text_line_height, text, ctrl->text_length, style->text_color, ctrl->text_word_wrap_at_width);
 }
 
 void VuiCheckBoxCheck_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
 	VuiCtrl* parent = vui_ctrl_get(ctrl->parent_id);
+	const VuiCtrlStyle* parent_style = &vui_ctrl_cold(parent)->style;
 	VuiBool is_active = (parent->state_flags & VuiCtrlStateFlags_active) == VuiCtrlStateFlags_active;
 	if (content_rect->left != content_rect->right)
-		vui_render_rect(content_rect, parent->style.check_color, parent->style.radius);
+		vui_render_rect(content_rect, parent_style->check_color, parent_style->radius);
 }
 
 void VuiProgressBar_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
 	VuiCtrl* parent = vui_ctrl_get(ctrl->parent_id);
-	vui_render_rect(content_rect, parent->style.bar_color, parent->style.radius);
+	const VuiCtrlStyle* parent_style = &vui_ctrl_cold(parent)->style;
+	vui_render_rect(content_rect, parent_style->bar_color, parent_style->radius);
 }
 
 void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio) {
@@ -2300,7 +3029,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 
 				VuiVec2 min_clip = VuiVec2_abs(VuiVec2_mul_scalar(VuiVec2_perp_right(vec_norm), item->line_dotted.width * 2.f));
 
-				VuiRect parent_clip_rect = _vui.render.clip_rect;
+				VuiRect parent_clip_rect = _vui_render.clip_rect;
 				VuiRect clip_rect;
 				clip_rect.left_top = VuiVec2_min(item->line_dotted.start_pos, item->line_dotted.end_pos);
 				clip_rect.right_bottom = VuiVec2_max(item->line_dotted.start_pos, item->line_dotted.end_pos);
@@ -2319,7 +3048,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 					clip_rect.bottom += diff;
 				}
 
-				_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &clip_rect);
+				_vui_render.clip_rect = VuiRect_clip(&_vui_render.clip_rect, &clip_rect);
 				// debug render
 				// vui_render_rect_border(&clip_rect, vui_color_asbestos, 0.f, 4.f);
 
@@ -2339,7 +3068,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 					start = VuiVec2_add(start, iteration_step_vec);
 				}
 
-				_vui.render.clip_rect = parent_clip_rect;
+				_vui_render.clip_rect = parent_clip_rect;
 				break;
 			};
 			case VuiCanvasItemType_line_dashed: {
@@ -2348,7 +3077,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 
 				VuiVec2 min_clip = VuiVec2_abs(VuiVec2_mul_scalar(VuiVec2_perp_right(vec_norm), item->line_dashed.width * 2.f));
 
-				VuiRect parent_clip_rect = _vui.render.clip_rect;
+				VuiRect parent_clip_rect = _vui_render.clip_rect;
 				VuiRect clip_rect;
 				clip_rect.left_top = VuiVec2_min(item->line_dashed.start_pos, item->line_dashed.end_pos);
 				clip_rect.right_bottom = VuiVec2_max(item->line_dashed.start_pos, item->line_dashed.end_pos);
@@ -2367,7 +3096,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 					clip_rect.bottom += diff;
 				}
 
-				_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &clip_rect);
+				_vui_render.clip_rect = VuiRect_clip(&_vui_render.clip_rect, &clip_rect);
 				// debug render
 				// vui_render_rect_border(&clip_rect, vui_color_asbestos, 0.f, 4.f);
 
@@ -2386,7 +3115,7 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 					start = VuiVec2_add(start, iteration_step_vec);
 				}
 
-				_vui.render.clip_rect = parent_clip_rect;
+				_vui_render.clip_rect = parent_clip_rect;
 				break;
 			};
 			case VuiCanvasItemType_rect:
@@ -2414,7 +3143,72 @@ void VuiCanvas_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio)
 	}
 }
 
-static VuiVec2 vui_get_text_size(char* text, uint32_t text_length, float word_wrap_at_width, VuiFontId font_id, float line_height) {
+#define _vui_text_size_cache_null_idx UINT32_MAX
+
+static uint32_t _vui_text_size_cache_find_slot(_VuiTextSizeCache* cache, uint64_t text_hash, uint32_t text_length, VuiFontId font_id, float line_height, float word_wrap_at_width) {
+	uint32_t mask = cache->slots_cap - 1;
+	uint32_t slot_idx = (uint32_t)text_hash & mask;
+	while (cache->slots[slot_idx]) {
+		_VuiTextSizeCacheEntry* entry = &cache->entries[cache->slots[slot_idx] - 1];
+		if (
+			entry->text_hash == text_hash && entry->text_length == text_length && entry->font_id == font_id &&
+			entry->line_height == line_height && entry->word_wrap_at_width == word_wrap_at_width
+		) {
+			break;
+		}
+		slot_idx = (slot_idx + 1) & mask;
+	}
+	return slot_idx;
+}
+
+static void _vui_text_size_cache_lru_unlink(_VuiTextSizeCache* cache, uint32_t entry_idx) {
+	_VuiTextSizeCacheEntry* entry = &cache->entries[entry_idx];
+	if (entry->lru_prev_idx != _vui_text_size_cache_null_idx) {
+		cache->entries[entry->lru_prev_idx].lru_next_idx = entry->lru_next_idx;
+	} else {
+		cache->lru_head_idx = entry->lru_next_idx;
+	}
+	if (entry->lru_next_idx != _vui_text_size_cache_null_idx) {
+		cache->entries[entry->lru_next_idx].lru_prev_idx = entry->lru_prev_idx;
+	} else {
+		cache->lru_tail_idx = entry->lru_prev_idx;
+	}
+}
+
+static void _vui_text_size_cache_lru_push_head(_VuiTextSizeCache* cache, uint32_t entry_idx) {
+	_VuiTextSizeCacheEntry* entry = &cache->entries[entry_idx];
+	entry->lru_prev_idx = _vui_text_size_cache_null_idx;
+	entry->lru_next_idx = cache->lru_head_idx;
+	if (cache->lru_head_idx != _vui_text_size_cache_null_idx) {
+		cache->entries[cache->lru_head_idx].lru_prev_idx = entry_idx;
+	} else {
+		cache->lru_tail_idx = entry_idx;
+	}
+	cache->lru_head_idx = entry_idx;
+}
+
+//
+// empties the slot of an entry that is being replaced.
+// any following entries are shifted back into the hole if their home slot is at or before the hole.
+static void _vui_text_size_cache_remove_slot(_VuiTextSizeCache* cache, uint32_t slot_idx) {
+	uint32_t mask = cache->slots_cap - 1;
+	uint32_t hole_idx = slot_idx;
+	uint32_t next_idx = slot_idx;
+	while (1) {
+		next_idx = (next_idx + 1) & mask;
+		uint32_t next = cache->slots[next_idx];
+		if (next == 0) break;
+
+		uint32_t home_idx = (uint32_t)cache->entries[next - 1].text_hash & mask;
+		if (((next_idx - home_idx) & mask) >= ((next_idx - hole_idx) & mask)) {
+			cache->slots[hole_idx] = next;
+			hole_idx = next_idx;
+		}
+	}
+	cache->slots[hole_idx] = 0;
+}
+
+static VuiVec2 _vui_position_text_size(char* text, uint32_t text_length, float word_wrap_at_width, VuiFontId font_id, float line_height) {
 	VuiPositionTextArgs args = {0};
 	args.userdata = _vui.position_text_userdata;
 	args.font_id = font_id;
@@ -2425,6 +3219,113 @@ static VuiVec2 vui_get_text_size(char* text, uint32_t text_length, float word_wr
 	return _vui.position_text_fn(&args).vec2;
 }
 
+static VuiVec2 vui_get_text_size(char* text, uint32_t text_length, float word_wrap_at_width, VuiFontId font_id, float line_height) {
+	_VuiTextSizeCache* cache = &_vui.text_size_cache;
+	if (vui_text_size_cache_cap == 0 || !(_vui.flags & _VuiFlags_text_size_cache)) {
+		return _vui_position_text_size(text, text_length, word_wrap_at_width, font_id, line_height);
+	}
+
+	//
+	// while a window is being rendered the cache is only read, as other windows can be rendering on other threads.
+	// so it is not set up or cleared here, and the text is measured directly if the sizes could be out of date.
+	uint32_t glyphs_epoch = _vui_atomic_load_u32(&_vui_glyphs_epoch);
+	if (_vui_render_state) {
+		if (cache->slots && cache->glyphs_epoch == glyphs_epoch) {
+			uint64_t text_hash = _vui_hash_64_lanes(text, text_length, 0);
+			uint32_t slot_idx = _vui_text_size_cache_find_slot(cache, text_hash, text_length, font_id, line_height, word_wrap_at_width);
+			if (cache->slots[slot_idx]) {
+				return cache->entries[cache->slots[slot_idx] - 1].size;
+			}
+		}
+		return _vui_position_text_size(text, text_length, word_wrap_at_width, font_id, line_height);
+	}
+
+	if (cache->slots == NULL) {
+		uint32_t slots_cap = 1;
+		while (slots_cap < vui_text_size_cache_cap * 2) slots_cap *= 2;
+		cache->entries = vui_mem_alloc_array(_VuiTextSizeCacheEntry, _vui.allocator, vui_text_size_cache_cap);
+		cache->slots = vui_mem_alloc_array(uint32_t, _vui.allocator, slots_cap);
+		if (!cache->entries || !cache->slots) {
+			_vui.flags |= _VuiFlags_out_of_memory;
+			return _vui_position_text_size(text, text_length, word_wrap_at_width, font_id, line_height);
+		}
+		memset(cache->slots, 0, slots_cap * sizeof(uint32_t));
+		cache->slots_cap = slots_cap;
+		cache->count = 0;
+		cache->lru_head_idx = _vui_text_size_cache_null_idx;
+		cache->lru_tail_idx = _vui_text_size_cache_null_idx;
+	}
+
+	//
+	// the glyphs the sizes were measured with may have been removed, so measure everything again.
+	if (cache->glyphs_epoch != glyphs_epoch) {
+		vui_text_size_cache_clear();
+		cache->glyphs_epoch = glyphs_epoch;
+	}
+
+	uint64_t text_hash = _vui_hash_64_lanes(text, text_length, 0);
+	uint32_t slot_idx = _vui_text_size_cache_find_slot(cache, text_hash, text_length, font_id, line_height, word_wrap_at_width);
+
+	if (cache->slots[slot_idx]) {
+		uint32_t entry_idx = cache->slots[slot_idx] - 1;
+		if (cache->lru_head_idx != entry_idx) {
+			_vui_text_size_cache_lru_unlink(cache, entry_idx);
+			_vui_text_size_cache_lru_push_head(cache, entry_idx);
+		}
+		cache->stats.hits += 1;
+		return cache->entries[entry_idx].size;
+	}
+	cache->stats.misses += 1;
+
+	VuiVec2 size = _vui_position_text_size(text, text_length, word_wrap_at_width, font_id, line_height);
+
+	//
+	// take a new entry, or replace the least recently used one when it is full.
+	uint32_t entry_idx;
+	if (cache->count < vui_text_size_cache_cap) {
+		entry_idx = cache->count;
+		cache->count += 1;
+	} else {
+		entry_idx = cache->lru_tail_idx;
+		_VuiTextSizeCacheEntry* old = &cache->entries[entry_idx];
+		_vui_text_size_cache_remove_slot(cache, _vui_text_size_cache_find_slot(cache, old->text_hash, old->text_length, old->font_id, old->line_height, old->word_wrap_at_width));
+		_vui_text_size_cache_lru_unlink(cache, entry_idx);
+		cache->stats.evictions += 1;
+
+		//
+		// the removal can shift the slots along, so find the empty one again.
+		slot_idx = _vui_text_size_cache_find_slot(cache, text_hash, text_length, font_id, line_height, word_wrap_at_width);
+	}
+
+	_VuiTextSizeCacheEntry* entry = &cache->entries[entry_idx];
+	entry->text_hash = text_hash;
+	entry->text_length = text_length;
+	entry->font_id = font_id;
+	entry->line_height = line_height;
+	entry->word_wrap_at_width = word_wrap_at_width;
+	entry->size = size;
+	cache->slots[slot_idx] = entry_idx + 1;
+	_vui_text_size_cache_lru_push_head(cache, entry_idx);
+	return size;
+}
+
+VuiTextSizeCacheStats vui_text_size_cache_stats() {
+	VuiTextSizeCacheStats stats = _vui.text_size_cache.stats;
+	stats.count = _vui.text_size_cache.count;
+	stats.cap = vui_text_size_cache_cap;
+	return stats;
+}
+
+void vui_text_size_cache_clear() {
+	_VuiTextSizeCache* cache = &_vui.text_size_cache;
+	if (cache->slots) {
+		memset(cache->slots, 0, cache->slots_cap * sizeof(uint32_t));
+	}
+	cache->count = 0;
+	cache->lru_head_idx = _vui_text_size_cache_null_idx;
+	cache->lru_tail_idx = _vui_text_size_cache_null_idx;
+}
+
 static VuiVec2 vui_get_text_cursor_pos(char* text, uint32_t text_length, float word_wrap_at_width, VuiFontId font_id, float line_height, uint32_t cursor_idx) {
 	VuiPositionTextArgs args = {0};
 	args.userdata = _vui.position_text_userdata;
@@ -2456,7 +3357,7 @@ void VuiTextBoxCursor_render(VuiCtrl* ctrl, VuiRect* content_rect, float interp_
 		// move up to the scroll view if this is multiline text box
 		parent = vui_ctrl_get(parent->parent_id);
 	}
-	const VuiCtrlStyle* style = &parent->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(parent)->style;
 	const VuiCtrlStyle* text_styles = parent->styles[0].text_styles;
 
 	//
@@ -2557,10 +3458,15 @@ void vui_ctrl_start_(VuiCtrlSibId sib_id, VuiCtrlFlags flags, VuiActiveChange ac
 
 	//
 	// try to find the control in the existing tree.
-	VuiCtrl* ctrl = parent_ctrl->child_first_id ? vui_ctrl_get(parent_ctrl->child_first_id) : NULL;
-	while (ctrl) {
-		if (ctrl->sib_id == sib_id) break;
-		ctrl = ctrl->sibling_next_id ? vui_ctrl_get(ctrl->sibling_next_id) : NULL;
+	// most of the time the UI is built in the same order as the last frame,
+	// so first check the control that comes after the previous sibling.
+	// otherwise fallback to looking it up in the sibling hash table.
+	VuiCtrlId expected_ctrl_id = _vui.build.sibling_prev_ctrl_id
+		? vui_ctrl_get(_vui.build.sibling_prev_ctrl_id)->sibling_next_id
+		: parent_ctrl->child_first_id;
+	VuiCtrl* ctrl = vui_ctrl_try_get(expected_ctrl_id);
+	if (ctrl == NULL || ctrl->sib_id != sib_id) {
+		ctrl = vui_ctrl_try_get(_VuiCtrlSibTable_get(&_vui.ctrl_sib_table, parent_ctrl->id, sib_id));
 	}
 
 	if (ctrl) {
@@ -2581,11 +3487,17 @@ void vui_ctrl_start_(VuiCtrlSibId sib_id, VuiCtrlFlags flags, VuiActiveChange ac
 		ctrl->sib_id = sib_id;
 
 		_vui_ctrl_insert(ctrl);
+
+		//
+		// the allocation may have grown the pool, so the parent pointer could be stale.
+		parent_ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
 	}
 
 	//
 	// set the new state
 	ctrl->last_frame_idx = _vui.build.frame_idx;
+	ctrl->children_touched_count = 0;
+	parent_ctrl->children_touched_count += 1;
 	VuiCtrlFlags sb_flags = ctrl->flags & (_VuiCtrlFlags_show_vertical_bar | _VuiCtrlFlags_show_horizontal_bar);
 	ctrl->flags = flags | sb_flags;
 	ctrl->render_fn = render_fn;
@@ -2664,16 +3576,88 @@ void vui_ctrl_start_(VuiCtrlSibId sib_id, VuiCtrlFlags flags, VuiActiveChange ac
 		ctrl->state = state;
 		ctrl->state_time = 0.f;
 		if (ctrl->attributes.style_transition_time) {
-			ctrl->prev_style = ctrl->style;
-			ctrl->prev_animate_aux = ctrl->animate_aux;
+			VuiCtrlCold* cold = vui_ctrl_cold(ctrl);
+			cold->prev_style = cold->style;
+			cold->prev_animate_aux = cold->animate_aux;
 		}
 	}
 
 	_VuiCtrl_style_interp(ctrl, _vui.build.dt);
+
+	//
+	// animations change every frame without anything in the build changing.
+	VuiBool is_animating = ctrl->state_time < ctrl->attributes.style_transition_time ||
+		(styles && (styles[0].pre_animate_fn || styles[0].post_animate_fn));
+	if (is_animating) {
+		_vui.build.is_render_forced = vui_true;
+	}
+
+	//
+	// if this control can change without the content hash of the cache it is in changing,
+	// then make sure the cache gets rebuilt next frame.
+	if (_vui.build.cache_ctrl_id) {
+		if (ctrl->focus_state || is_animating || (flags & _VuiCtrlFlags_is_popover)) {
+			_vui_cache_get(vui_ctrl_get(_vui.build.cache_ctrl_id))->needs_rebuild = vui_true;
+		}
+	}
+}
+
+//
+// adds everything the control renders from to the window's structural hash.
+// the rectangles are added later when the layout is finalized.
+void _vui_ctrl_build_hash(VuiCtrl* ctrl) {
+	_vui_build_hash(&ctrl->id, sizeof(VuiCtrlId));
+	_vui_build_hash(&ctrl->state_flags, sizeof(VuiCtrlStateFlags));
+	_vui_build_hash(&ctrl->focus_state, sizeof(VuiFocusState));
+	_vui_build_hash(&ctrl->render_fn, sizeof(VuiCtrlRenderFn));
+	_vui_build_hash(&ctrl->state, sizeof(VuiCtrlState));
+	_vui_build_hash(&ctrl->prev_state, sizeof(VuiCtrlState));
+	_vui_build_hash(&ctrl->styles, sizeof(ctrl->styles));
+	_vui_build_hash(&ctrl->attributes, sizeof(VuiCtrlAttrs));
+	_vui_build_hash(&vui_ctrl_cold(ctrl)->style, sizeof(VuiCtrlStyle));
+
+	if (ctrl->render_fn == VuiText_render) {
+		_vui_build_hash(&_vui.build.w->text[ctrl->text_start_idx], ctrl->text_length);
+		_vui_build_hash(&ctrl->text_word_wrap_at_width, sizeof(uint32_t));
+	} else if (ctrl->render_fn == VuiImage_render) {
+		_vui_build_hash(&ctrl->image_id, sizeof(VuiImageId));
+		_vui_build_hash(&ctrl->image_tint, sizeof(VuiColor));
+		//
+		// the image can move when the texture it lives in is repacked.
+		_vui_build_hash(vui_image_get(ctrl->image_id), sizeof(VuiImage));
+	} else if (ctrl->render_fn == VuiCanvas_render) {
+		_vui_build_hash(ctrl->canvas_items, VuiStk_count(ctrl->canvas_items) * sizeof(VuiCanvasItem));
+	} else if (ctrl->render_fn == VuiTextBoxCursor_render) {
+		//
+		// the cursor is rendered from the input state rather than the control.
+		VuiCtrl* parent = vui_ctrl_get(ctrl->parent_id);
+		if (parent->styles == NULL) {
+			parent = vui_ctrl_get(parent->parent_id);
+		}
+		if (vui_ctrl_is_focused(parent->id) && _vui.input.focused_text_box.string) {
+			_vui_build_hash(&_vui.input.focused_text_box.cursor_idx, sizeof(_vui.input.focused_text_box.cursor_idx));
+			_vui_build_hash(&_vui.input.focused_text_box.select_offset, sizeof(_vui.input.focused_text_box.select_offset));
+		}
+	} else if (ctrl->flags & _VuiCtrlFlags_is_cache) {
+		_vui_build_hash(&_vui_cache_get(ctrl)->build_hash, sizeof(uint64_t));
+	}
 }
 
 void vui_ctrl_end() {
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
+
+	//
+	// if some of the children were not started this frame, then they are old and need removing.
+	// let the parents know so _vui_remove_old_ctrls only has to visit the controls that have old descendants.
+	if (ctrl->children_touched_count != ctrl->children_count) {
+		ctrl->flags |= _VuiCtrlFlags_has_old_descendants;
+	}
+	if ((ctrl->flags & _VuiCtrlFlags_has_old_descendants) && ctrl->parent_id) {
+		vui_ctrl_get(ctrl->parent_id)->flags |= _VuiCtrlFlags_has_old_descendants;
+	}
+
+	_vui_ctrl_build_hash(ctrl);
+
 	_vui.build.parent_ctrl_id = ctrl->parent_id;
 	_vui.build.sibling_prev_ctrl_id = ctrl->id;
 }
@@ -2688,7 +3672,7 @@ void vui_text_(VuiCtrlSibId sib_id, char* text, uint32_t text_length, float word
 
 	vui_ctrl_start_(sib_id, 0, 0, styles, VuiText_render);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 
 	{
 		VuiVec2 size = vui_get_text_size(text, text_length, word_wrap_at_width, style->font_id, style->text_line_height);
@@ -2713,7 +3697,7 @@ void vui_text_(VuiCtrlSibId sib_id, char* text, uint32_t text_length, float word
 void vui_image(VuiCtrlSibId sib_id, VuiImageId image_id, VuiColor image_tint, const VuiCtrlStyle styles[VuiCtrlState_COUNT]) {
 	vui_ctrl_start_(sib_id, 0, 0, styles, VuiImage_render);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	VuiCtrlStyle* style = &ctrl->style;
+	VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 	VuiImage* image = vui_image_get(image_id);
 	if (ctrl->attributes.width == vui_auto_len) {
 		ctrl->attributes.width = image->width + VuiThickness_horizontal(&style->padding);
@@ -2744,7 +3728,7 @@ void vui_separator(VuiCtrlSibId sib_id, const VuiCtrlStyle styles[VuiCtrlState_C
 
 	vui_ctrl_start_(sib_id, 0, 0, styles, NULL);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 
 	ctrl->attributes.width = is_row ? vui_fill_len : style->separator_size;
 	ctrl->attributes.height = is_row ? style->separator_size : vui_fill_len;
@@ -2981,7 +3965,7 @@ VuiBool vui_check_box(VuiCtrlSibId sib_id, VuiBool* checked, const VuiCtrlStyle
 
 	vui_ctrl_start_(sib_id, VuiCtrlFlags_focusable | VuiCtrlFlags_toggleable, checked ? *checked + 1 : 0, styles, NULL);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 	ctrl->attributes.width = style->check_box_size;
 	ctrl->attributes.height = style->check_box_size;
 
@@ -3079,7 +4063,7 @@ VuiBool vui_radio_button(VuiCtrlSibId sib_id, VuiCtrlSibId* selected_sib_id, con
 	VuiBool is_active = vui_false;
 	vui_ctrl_start_(sib_id, VuiCtrlFlags_focusable | VuiCtrlFlags_selectable, (*selected_sib_id == sib_id) + 1, styles, NULL);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 	ctrl->attributes.width = style->check_box_size;
 	ctrl->attributes.height = style->check_box_size;
 
@@ -3185,7 +4169,7 @@ VuiBool _vui_slider(VuiCtrlSibId sib_id, void* value_out, void* min, void* max,
 	VuiBool released = vui_false;
 	vui_scope_align(VuiAlign_left_top) {
 		VuiCtrl* parent = vui_ctrl_get(_vui.build.parent_ctrl_id);
-		const VuiCtrlStyle* style = &parent->style;
+		const VuiCtrlStyle* style = &vui_ctrl_cold(parent)->style;
 
 		//
 		// the child styles are only in the VuiCtrlState_default style
@@ -3299,7 +4283,7 @@ void VuiCtrl_set_scroll_offset(VuiCtrl* ctrl, VuiVec2 offset, VuiBool holding_sc
 	// when a scroll bar is visible.
 	VuiVec2 container_size = VuiRect_size(ctrl->rect);
 	{
-		const VuiCtrlStyle* style = &ctrl->style;
+		const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 		//
 		// the child styles are only in the VuiCtrlState_default style
 		const VuiCtrlStyle* bar_styles = ctrl->styles[0].bar_styles;
@@ -3405,7 +4389,7 @@ VuiBool _vui_scroll_bar(VuiCtrlSibId sib_id, float length, float container_lengt
 	vui_scope_height(is_horizontal ? vui_auto_len : length)
 	vui_ctrl_start(sib_id, styles);
 	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 	//
 	// the child styles are only in the VuiCtrlState_default style
 	const VuiCtrlStyle* slider_styles = styles[0].slider_styles;
@@ -3481,7 +4465,7 @@ void vui_scroll_view_end() {
 	VuiCtrl* content = vui_ctrl_get(scroll_view->scroll_content_id);
 	VuiVec2 content_size = VuiRect_size(content->rect);
 	VuiVec2 container_size = VuiRect_size(scroll_view->rect);
-	const VuiCtrlStyle* style = &scroll_view->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(scroll_view)->style;
 	//
 	// the child styles are only in the VuiCtrlState_default style
 	const VuiCtrlStyle* bar_styles = scroll_view->styles[0].bar_styles;
@@ -3621,6 +4605,62 @@ void vui_scroll_view_end() {
 	vui_ctrl_end();
 }
 
+void vui_list_view_start_(VuiCtrlSibId sib_id, uint32_t row_count, float row_height, uint32_t* visible_start_idx_out, uint32_t* visible_end_idx_out, VuiVec2* content_offset_in_out, VuiVec2* size_in_out, VuiScrollFlags flags, const VuiCtrlStyle styles[VuiCtrlState_COUNT]) {
+	vui_assert(row_height > 0.f, "the row height of a list view must be greater than 0");
+	vui_scroll_view_start_(sib_id, content_offset_in_out, size_in_out, flags | VuiScrollFlags_vertical, styles);
+
+	VuiCtrl* content = vui_ctrl_get(_vui.build.parent_ctrl_id);
+	VuiCtrl* scroll_view = vui_ctrl_get(content->parent_id);
+	content->layout_type = VuiLayoutType_row;
+	content->attributes.layout_spacing = 0.f;
+	content->attributes.layout_wrap = vui_false;
+
+	//
+	// work out the height of the viewport using the size of the scroll view from the last frame.
+	// if it has not been laid out yet, then fallback to the height of the window.
+	const VuiCtrlStyle* style = &vui_ctrl_cold(scroll_view)->style;
+	float viewport_height = VuiRect_height(&scroll_view->rect) - style->border_width * 2.f - VuiThickness_vertical(&style->padding);
+	if (viewport_height <= 0.f) {
+		viewport_height = _vui.build.w->size.y;
+	}
+
+	//
+	// the scroll offset is always <= 0, so negate it to get the distance scrolled from the top.
+	float scrolled = -scroll_view->scroll_offset.y;
+	float start_row = scrolled / row_height;
+	float end_row = ceilf((scrolled + viewport_height) / row_height) + 1.f;
+	uint32_t start_idx = start_row < row_count ? (uint32_t)start_row : row_count;
+	uint32_t end_idx = end_row < row_count ? (uint32_t)end_row : row_count;
+
+	content->list_view_row_count = row_count;
+	content->list_view_end_idx = end_idx;
+	content->list_view_row_height = row_height;
+
+	//
+	// the rows that are not built above the visible range are replaced with a single spacer.
+	// this keeps the content the same size so the scroll bars stay correct.
+	vui_scope_align(VuiAlign_left_top)
+	vui_scope_offset(0.f, 0.f)
+	vui_spacing(-1, 0.f, start_idx * row_height);
+
+	*visible_start_idx_out = start_idx;
+	*visible_end_idx_out = end_idx;
+}
+
+void vui_list_view_end() {
+	VuiCtrl* content = vui_ctrl_get(_vui.build.parent_ctrl_id);
+	uint32_t remaining_count = content->list_view_row_count - content->list_view_end_idx;
+	float row_height = content->list_view_row_height;
+
+	//
+	// replace the rows that are not built below the visible range with a single spacer.
+	vui_scope_align(VuiAlign_left_top)
+	vui_scope_offset(0.f, 0.f)
+	vui_spacing(-2, 0.f, remaining_count * row_height);
+
+	vui_scroll_view_end();
+}
+
 static VuiBool _vui_text_box(VuiCtrlSibId sib_id, char* string_in_out, uint32_t string_in_out_cap, const VuiCtrlStyle styles[VuiCtrlState_COUNT], _VuiInputBoxType type, VuiBool is_multiline, VuiVec2* content_offset_in_out, VuiVec2* size_in_out, VuiScrollFlags flags) {
 	vui_scope_height(vui_auto_len) {
 		if (is_multiline) {
@@ -3640,7 +4680,7 @@ static VuiBool _vui_text_box(VuiCtrlSibId sib_id, char* string_in_out, uint32_t
 	}
 	VuiCtrl* ctrl = vui_ctrl_get(text_box_ctrl_id);
 
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlStyle* style = &vui_ctrl_cold(ctrl)->style;
 	//
 	// the child styles are only in the VuiCtrlState_default style
 	const VuiCtrlStyle* text_styles = styles[0].text_styles;
@@ -4003,6 +5043,131 @@ void vui_canvas_bezier_curve(VuiVec2 points[4], VuiColor color, float width) {
 	item->color = color;
 }
 
+static VuiBool _vui_ctrl_is_descendant(VuiCtrlId ctrl_id, VuiCtrlId ancestor_id) {
+	VuiCtrl* ctrl = vui_ctrl_try_get(ctrl_id);
+	while (ctrl) {
+		if (ctrl->parent_id == ancestor_id) return vui_true;
+		ctrl = vui_ctrl_try_get(ctrl->parent_id);
+	}
+	return vui_false;
+}
+
+//
+// moves the text controls in the subtree to point to the new location of their text in _VuiWindow.text
+static void _vui_cache_rebase_text(VuiCtrl* ctrl, uint32_t offset) {
+	VuiCtrl* child = NULL;
+	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; child_id = child->sibling_next_id) {
+		child = vui_ctrl_get(child_id);
+		if (child->render_fn == VuiText_render) {
+			child->text_start_idx += offset;
+		} else if (child->flags & _VuiCtrlFlags_is_cache) {
+			_vui_cache_get(child)->text_start_idx += offset;
+		}
+		_vui_cache_rebase_text(child, offset);
+	}
+}
+
+VuiBool vui_cache_start(VuiCtrlSibId sib_id, uint64_t content_hash) {
+	vui_ctrl_start_(sib_id, _VuiCtrlFlags_is_cache, 0, NULL, NULL);
+	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
+	if (ctrl->cache_id == 0) {
+		VuiPoolId pool_id = 0;
+		_VuiCache* new_cache = _VuiPool_alloc((_VuiPool*)&_vui.cache_pool, &pool_id, sizeof(_VuiCache), alignof(_VuiCache));
+		vui_assert(new_cache, "failed to allocate the cache");
+		memset(new_cache, 0, sizeof(_VuiCache));
+		ctrl->cache_id = pool_id;
+	}
+	_VuiCache* cache = _vui_cache_get(ctrl);
+
+	VuiBool is_hit = cache->is_built && !cache->needs_rebuild && cache->built_renders_epoch == _vui_renders_epoch() &&
+		cache->content_hash == content_hash && cache->state_flags == ctrl->state_flags;
+
+	//
+	// the controls must be built if the user is interacting with any of them.
+	if (is_hit) {
+		is_hit = !_vui_ctrl_is_descendant(_vui.build.w->focused_ctrl_id, ctrl->id) &&
+			!_vui_ctrl_is_descendant(_vui.mouse_focused_ctrl_id, ctrl->id) &&
+			!_vui_ctrl_is_descendant(_vui.mouse_scroll_focused_ctrl_id, ctrl->id);
+	}
+
+	cache->outer_cache_ctrl_id = _vui.build.cache_ctrl_id;
+	_vui.build.cache_ctrl_id = ctrl->id;
+
+	if (is_hit) {
+		ctrl->flags |= _VuiCtrlFlags_is_cache_hit;
+		ctrl->children_touched_count = ctrl->children_count;
+
+		//
+		// put the text of the subtree back into the window's text buffer.
+		// if it is in a different place to last time, then update the text controls to point to it.
+		uint32_t text_start_idx = VuiStk_count(_vui.build.w->text);
+		uint32_t text_length = VuiStk_count(cache->text);
+		if (text_length) {
+			char* t = VuiStk_push_many(&_vui.build.w->text, text_length);
+			vui_ensure_alloc_ok(t, vui_false);
+			memcpy(t, cache->text, text_length);
+		}
+
+		if (text_start_idx != cache->text_start_idx) {
+			_vui_cache_rebase_text(ctrl, text_start_idx - cache->text_start_idx);
+			cache->text_start_idx = text_start_idx;
+		}
+		return vui_false;
+	}
+
+	for (uint32_t i = 0; i < _VUI_CACHE_LAYOUTS_COUNT; i += 1) {
+		cache->layouts[i].is_valid = vui_false;
+	}
+
+	//
+	// hash the subtree on its own, so the result can be reused when it is a hit.
+	cache->outer_build_hash = _vui.build.hash;
+	_vui.build.hash = vui_fnv_hash_64_initial;
+
+	cache->content_hash = content_hash;
+	cache->state_flags = ctrl->state_flags;
+	cache->is_built = vui_true;
+	cache->built_renders_epoch = _vui_renders_epoch();
+	cache->needs_rebuild = vui_false;
+	cache->built_frame_idx = _vui.build.frame_idx;
+	cache->text_start_idx = VuiStk_count(_vui.build.w->text);
+	return vui_true;
+}
+
+void vui_cache_end(void) {
+	VuiCtrl* ctrl = vui_ctrl_get(_vui.build.parent_ctrl_id);
+	vui_assert(ctrl->flags & _VuiCtrlFlags_is_cache, "vui_cache_end must be called after vui_cache_start once all of the child controls have ended");
+	_VuiCache* cache = _vui_cache_get(ctrl);
+
+	//
+	// the controls have been built this frame, so keep a copy of the text they pushed.
+	if (!(ctrl->flags & _VuiCtrlFlags_is_cache_hit)) {
+		uint32_t text_length = VuiStk_count(_vui.build.w->text) - cache->text_start_idx;
+		VuiStk_clear(cache->text);
+		if (text_length) {
+			char* t = VuiStk_push_many(&cache->text, text_length);
+			if (t) {
+				memcpy(t, &_vui.build.w->text[cache->text_start_idx], text_length);
+			} else {
+				_vui.flags |= _VuiFlags_out_of_memory;
+				cache->is_built = vui_false;
+			}
+		}
+
+		cache->build_hash = _vui.build.hash;
+		_vui.build.hash = cache->outer_build_hash;
+	}
+
+	//
+	// the outer cache contains all of our controls, so if we need rebuilding then so does it.
+	_vui.build.cache_ctrl_id = cache->outer_cache_ctrl_id;
+	if (cache->needs_rebuild && _vui.build.cache_ctrl_id) {
+		_vui_cache_get(vui_ctrl_get(_vui.build.cache_ctrl_id))->needs_rebuild = vui_true;
+	}
+
+	vui_ctrl_end();
+}
+
 // ===========================================================================================
 //
 //
@@ -4046,10 +5211,12 @@ void vui_image_remove(VuiImageId image_id) {
 	uint16_t counter = (image_id & _VuiImageId_counter_MASK) >> _VuiImageId_counter_SHIFT;
 	_VuiImage* image = _VuiPool_id_to_ptr((_VuiPool*)&_vui.image_pool, pool_id, sizeof(_VuiImage));
 	vui_assert(image->counter == counter, "trying to remove an image with an old identifier");
-	_VuiPool_dealloc((_VuiPool*)&_vui.image_pool, pool_id, sizeof(_VuiImage), alignof(_VuiImage));
+	_VuiPool_dealloc((_VuiPool*)&_vui.image_pool, pool_id);
 }
 
-VuiBool vui_init(VuiSetup* setup) {
+//
+// sets up the current context, this does not touch vui_ss as that is shared by every context.
+static void _vui_context_init(VuiSetup* setup) {
 	_vui = (_Vui){0};
 	_vui.position_text_fn = setup->position_text_fn;
 	_vui.position_text_userdata = setup->position_text_userdata;
@@ -4059,6 +5226,16 @@ VuiBool vui_init(VuiSetup* setup) {
 	memset(_vui.windows, 0, setup->windows_count * sizeof(*_vui.windows));
 	_vui.windows_count = setup->windows_count;
 	_VuiPool_init((_VuiPool*)&_vui.ctrl_pool, setup->ctrls_init_cap ? setup->ctrls_init_cap : _vui_ctrls_init_cap, sizeof(_VuiCtrl), alignof(_VuiCtrl));
+	if (setup->scissor_clipping) {
+		_vui.flags |= _VuiFlags_scissor_clipping;
+	}
+	if (setup->text_size_cache) {
+		_vui.flags |= _VuiFlags_text_size_cache;
+	}
+}
+
+VuiBool vui_init(VuiSetup* setup) {
+	_vui_context_init(setup);
 
 	vui_ss.text_header[VuiCtrlState_default].font_id = setup->default_font_id;
 	vui_ss.text_header[VuiCtrlState_focused].font_id = setup->default_font_id;
@@ -4071,15 +5248,119 @@ VuiBool vui_init(VuiSetup* setup) {
 	return vui_true;
 }
 
-void _vui_find_mouse_focused_ctrls(VuiCtrl* ctrl, VuiBool is_root) {
+VuiContext* vui_context_create(VuiSetup* setup) {
+	_Vui* ctx = vui_mem_alloc(setup->allocator, sizeof(_Vui), alignof(_Vui));
+	if (!ctx) return NULL;
+
+	_Vui* prev_ctx = _vui_ctx;
+	_vui_ctx = ctx;
+	_vui_context_init(setup);
+	_vui_ctx = prev_ctx;
+	return ctx;
+}
+
+void vui_context_destroy(VuiContext* ctx) {
+	vui_assert(ctx != &_vui_default_ctx, "the default context cannot be destroyed");
+	_Vui* prev_ctx = _vui_ctx == ctx ? &_vui_default_ctx : _vui_ctx;
+	_vui_ctx = ctx;
+
+	//
+	// the controls own their canvas items and cache data.
+	for (uint32_t idx = 0; idx < _vui.ctrl_pool.cap; idx += 1) {
+		if (!_VuiPool_is_allocated((_VuiPool*)&_vui.ctrl_pool, idx))
+			continue;
+
+		VuiCtrl* ctrl = &((_VuiCtrl*)vui_ptr_add(_vui.ctrl_pool.VuiPool_data, _vui.ctrl_pool.elmts_start_byte_idx))[idx].inner;
+		if (ctrl->flags & _VuiCtrlFlags_is_canvas) {
+			VuiStk_deinit(ctrl->canvas_items);
+		} else if ((ctrl->flags & _VuiCtrlFlags_is_cache) && ctrl->cache_id) {
+			_VuiCache* cache = _vui_cache_get(ctrl);
+			VuiStk_deinit(cache->text);
+			VuiStk_deinit(cache->render_cmds);
+			VuiStk_deinit(cache->render_verts);
+			VuiStk_deinit(cache->render_indices);
+		}
+	}
+
+	for (uint32_t idx = 0; idx < _vui.windows_count; idx += 1) {
+		_VuiWindow* w = &_vui.windows[idx];
+		VuiStk_deinit(w->text);
+		for (uint32_t layer_idx = 0; layer_idx < VuiStk_count(w->render_layers); layer_idx += 1) {
+			VuiRenderLayer* layer = &w->render_layers[layer_idx];
+			VuiStk_deinit(layer->cmds);
+			VuiStk_deinit(layer->verts);
+			VuiStk_deinit(layer->indices);
+		}
+		VuiStk_deinit(w->render_layers);
+		VuiStk_deinit(w->render.cmds);
+		VuiStk_deinit(w->render.verts);
+		VuiStk_deinit(w->render.indices);
+		VuiStk_deinit(w->render.damage_rects);
+		VuiStk_deinit(w->removed_ctrl_bounds);
+
+		_VuiRenderState* render_state = &w->render_state;
+		for (uint32_t points_count = 0; points_count < VuiStk_count(render_state->unit_arcs); points_count += 1) {
+			VuiVec2* table = render_state->unit_arcs[points_count];
+			if (table) {
+				vui_mem_dealloc_array(VuiVec2, _vui.allocator, table, points_count * 4 + 1);
+			}
+		}
+		VuiStk_deinit(render_state->unit_arcs);
+		VuiStk_deinit(render_state->path_points);
+		VuiStk_deinit(render_state->merge_batches);
+		VuiStk_deinit(render_state->merge_next_cmd_idxs);
+		VuiStk_deinit(render_state->merge_cmds);
+		VuiStk_deinit(render_state->merge_indices);
+	}
+	vui_mem_dealloc_array(_VuiWindow, _vui.allocator, _vui.windows, _vui.windows_count);
+
+	VuiStk_deinit(_vui.build.disabled_stack);
+	VuiStk_deinit(_vui.build.popover_ctrl_ids);
+	if (_vui.text_size_cache.slots) {
+		vui_mem_dealloc_array(_VuiTextSizeCacheEntry, _vui.allocator, _vui.text_size_cache.entries, vui_text_size_cache_cap);
+		vui_mem_dealloc_array(uint32_t, _vui.allocator, _vui.text_size_cache.slots, _vui.text_size_cache.slots_cap);
+	}
+	if (_vui.ctrl_colds) {
+		vui_mem_dealloc_array(VuiCtrlCold, _vui.allocator, _vui.ctrl_colds, _vui.ctrl_colds_cap);
+	}
+	if (_vui.ctrl_sib_table.entries) {
+		vui_mem_dealloc_array(_VuiCtrlSibEntry, _vui.allocator, _vui.ctrl_sib_table.entries, _vui.ctrl_sib_table.cap);
+	}
+	_VuiPool_deinit((_VuiPool*)&_vui.ctrl_pool, sizeof(_VuiCtrl), alignof(_VuiCtrl));
+	if (_vui.image_pool.VuiPool_data) {
+		_VuiPool_deinit((_VuiPool*)&_vui.image_pool, sizeof(_VuiImage), alignof(_VuiImage));
+	}
+	if (_vui.cache_pool.VuiPool_data) {
+		_VuiPool_deinit((_VuiPool*)&_vui.cache_pool, sizeof(_VuiCache), alignof(_VuiCache));
+	}
+	for (void* arena = _vui.frame_data_alctor.arenas_head; arena;) {
+		void* next = ((_VuiArenaHeader*)arena)->next;
+		vui_mem_dealloc(_vui.allocator, arena, _VuiArenaAlctor_arena_size, 1);
+		arena = next;
+	}
+
+	vui_mem_dealloc(_vui.allocator, ctx, sizeof(_Vui), alignof(_Vui));
+	_vui_ctx = prev_ctx;
+}
+
+VuiContext* vui_context_current() {
+	return _vui_ctx;
+}
+
+void vui_context_set_current(VuiContext* ctx) {
+	_vui_ctx = ctx ? ctx : &_vui_default_ctx;
+}
+
+//
+// clip_rect is the area of the parent that is visible, this runs while building so it cannot use the render state.
+void _vui_find_mouse_focused_ctrls(VuiCtrl* ctrl, VuiBool is_root, VuiRect clip_rect) {
 	VuiVec2 mouse_pt = VuiVec2_init(_vui.input.mouse.x, _vui.input.mouse.y);
-	VuiRect parent_clip_rect = _vui.render.clip_rect;
 	if (ctrl->flags & _VuiCtrlFlags_is_popover) {
 		if (!(ctrl->flags & _VuiCtrlFlags_is_popover_open))
 			return;
 
 		VuiCtrl* root_ctrl = vui_ctrl_get(_vui.build.w->root_ctrl_id);
-		_vui.render.clip_rect = VuiRect_init(0, 0, root_ctrl->attributes.width, root_ctrl->attributes.height);
+		clip_rect = VuiRect_init(0, 0, root_ctrl->attributes.width, root_ctrl->attributes.height);
 		if (_vui.input.mouse.buttons_has_been_pressed & VuiMouseButtons_left) {
 			if (ctrl->popover_is_open_ptr && !VuiRect_intersects_pt(&ctrl->rect, mouse_pt)) {
 				ctrl->flags &= ~_VuiCtrlFlags_is_popover_open;
@@ -4087,14 +5368,14 @@ void _vui_find_mouse_focused_ctrls(VuiCtrl* ctrl, VuiBool is_root) {
 			}
 		}
 	} else {
-		_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &ctrl->rect);
+		clip_rect = VuiRect_clip(&clip_rect, &ctrl->rect);
 	}
 
-	if (!_vui.input.is_mouse_over_ctrl && !is_root && ctrl->style.bg_color.a != 0) {
+	if (!_vui.input.is_mouse_over_ctrl && !is_root && ctrl->box_style.bg_color.a != 0) {
 		_vui.input.is_mouse_over_ctrl = VuiRect_intersects_pt(&ctrl->rect, mouse_pt);
 	}
 
-	if (VuiRect_intersects_pt(&_vui.render.clip_rect, mouse_pt)) {
+	if (VuiRect_intersects_pt(&clip_rect, mouse_pt)) {
 		if (ctrl->flags & VuiCtrlFlags_focusable) {
 			_vui_ctrl_set_mouse_focused(ctrl->id);
 		}
@@ -4107,10 +5388,8 @@ void _vui_find_mouse_focused_ctrls(VuiCtrl* ctrl, VuiBool is_root) {
 	VuiCtrl* child = NULL;
 	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; child_id = child->sibling_next_id) {
 		child = vui_ctrl_get(child_id);
-		_vui_find_mouse_focused_ctrls(child, vui_false);
+		_vui_find_mouse_focused_ctrls(child, vui_false, clip_rect);
 	}
-
-	_vui.render.clip_rect = parent_clip_rect;
 }
 
 //
@@ -4415,8 +5694,7 @@ void vui_frame_start(VuiBool right_to_left, float dt) {
 		_vui.build.w = w;
 
 		if (_vui.mouse_focused_window_id == i && w->root_ctrl_id) {
-			_vui.render.clip_rect = VuiRect_init(0, 0, w->size.x, w->size.y);
-			_vui_find_mouse_focused_ctrls(vui_ctrl_get(w->root_ctrl_id), vui_true);
+			_vui_find_mouse_focused_ctrls(vui_ctrl_get(w->root_ctrl_id), vui_true, VuiRect_init(0, 0, w->size.x, w->size.y));
 		}
 
 		w->size.x = 0;
@@ -4741,6 +6019,8 @@ void vui_window_start(VuiWindowId id, VuiVec2 size) {
 		w->root_ctrl_id = id;
 	}
 	root_ctrl->last_frame_idx = _vui.build.frame_idx;
+	root_ctrl->children_touched_count = 0;
+	root_ctrl->flags &= ~_VuiCtrlFlags_has_old_descendants;
 
 	root_ctrl->attributes = _vui.build.ctrl_attrs;
 	root_ctrl->attributes.width = size.x;
@@ -4751,6 +6031,8 @@ void vui_window_start(VuiWindowId id, VuiVec2 size) {
 
 	_vui.build.parent_ctrl_id = root_ctrl->id;
 	_vui.build.sibling_prev_ctrl_id = 0;
+	_vui.build.hash = vui_fnv_hash_64_initial;
+	_vui.build.is_render_forced = vui_false;
 }
 
 /*
@@ -4888,7 +6170,7 @@ void _vui_layout_column_row(
 				float ratio = -child_dir_len;
 				available_dir_len -= inner_dir_len * ratio;
 			} else {
-				available_dir_len -= child_dir_len + margin_dir_len(&child->style.margin);
+				available_dir_len -= child_dir_len + margin_dir_len(&child->box_style.margin);
 			}
 		}
 
@@ -5039,11 +6321,76 @@ void _vui_layout_column_row(
 	if (wrap) *max_wrap_dir_inner_len_ptr -= wrap_spacing;
 }
 
+static int32_t _vui_cache_layout_find(_VuiCache* cache, VuiCtrl* ctrl, VuiRect* placement_area, float parent_inner_width, float parent_inner_height) {
+	VuiVec2 parent_inner_size = VuiVec2_init(parent_inner_width, parent_inner_height);
+	VuiVec2 fill_portion = VuiVec2_init(_vui.build.fill_portion_width, _vui.build.fill_portion_height);
+	VuiBool right_to_left = (_vui.flags & _VuiFlags_right_to_left) != 0;
+	for (uint32_t i = 0; i < _VUI_CACHE_LAYOUTS_COUNT; i += 1) {
+		_VuiCacheLayout* layout = &cache->layouts[i];
+		if (
+			layout->is_valid &&
+			layout->right_to_left == right_to_left &&
+			memcmp(&layout->placement_area, placement_area, sizeof(VuiRect)) == 0 &&
+			memcmp(&layout->parent_inner_size, &parent_inner_size, sizeof(VuiVec2)) == 0 &&
+			memcmp(&layout->fill_portion, &fill_portion, sizeof(VuiVec2)) == 0 &&
+			memcmp(&layout->attributes, &ctrl->attributes, sizeof(VuiCtrlAttrs)) == 0
+		) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+//
+// a cache that has not been rebuilt this frame can skip laying out its controls
+// if it gets laid out with the same inputs as a previous time.
+// the children are only laid out again in _vui_cache_layout_finalize if they hold the result of other inputs.
+static VuiBool _vui_cache_layout_try_skip(VuiCtrl* ctrl, VuiRect* placement_area, float parent_inner_width, float parent_inner_height) {
+	ctrl->flags &= ~_VuiCtrlFlags_is_cache_layout_skipped;
+	if (!(ctrl->flags & _VuiCtrlFlags_is_cache_hit)) return vui_false;
+
+	_VuiCache* cache = _vui_cache_get(ctrl);
+	int32_t layout_idx = _vui_cache_layout_find(cache, ctrl, placement_area, parent_inner_width, parent_inner_height);
+	if (layout_idx == -1) return vui_false;
+
+	ctrl->rect = cache->layouts[layout_idx].rect;
+	ctrl->flags |= _VuiCtrlFlags_is_cache_layout_skipped;
+	cache->skipped_layout_idx = layout_idx;
+	return vui_true;
+}
+
+static void _vui_cache_layout_store(VuiCtrl* ctrl, VuiRect* placement_area, float parent_inner_width, float parent_inner_height) {
+	_VuiCache* cache = _vui_cache_get(ctrl);
+
+	//
+	// replace the layout with the same inputs, otherwise the one that the children did not hold.
+	int32_t layout_idx = _vui_cache_layout_find(cache, ctrl, placement_area, parent_inner_width, parent_inner_height);
+	if (layout_idx == -1) {
+		layout_idx = (cache->children_layout_idx + 1) % _VUI_CACHE_LAYOUTS_COUNT;
+	}
+
+	_VuiCacheLayout* layout = &cache->layouts[layout_idx];
+	layout->is_valid = vui_true;
+	layout->right_to_left = (_vui.flags & _VuiFlags_right_to_left) != 0;
+	layout->attributes = ctrl->attributes;
+	layout->placement_area = *placement_area;
+	layout->parent_inner_size = VuiVec2_init(parent_inner_width, parent_inner_height);
+	layout->fill_portion = VuiVec2_init(_vui.build.fill_portion_width, _vui.build.fill_portion_height);
+	layout->rect = ctrl->rect;
+	cache->children_layout_idx = layout_idx;
+	cache->is_layout_absolute = vui_false;
+}
+
 void _vui_layout_ctrls(VuiCtrl* ctrl, VuiRect* placement_area, float parent_inner_width, float parent_inner_height) {
-	const VuiCtrlStyle* style = &ctrl->style;
+	const VuiCtrlBoxStyle* style = &ctrl->box_style;
 
 	ctrl->flags &= ~_VuiCtrlFlags_is_laid_out;
 
+	if (ctrl->flags & _VuiCtrlFlags_is_cache) {
+		if (_vui_cache_layout_try_skip(ctrl, placement_area, parent_inner_width, parent_inner_height))
+			return;
+	}
+
 	float parent_fill_portion_width = _vui.build.fill_portion_width;
 	float parent_fill_portion_height = _vui.build.fill_portion_height;
 	_vui.build.fill_portion_width = 0.f;
@@ -5316,6 +6663,69 @@ void _vui_layout_ctrls(VuiCtrl* ctrl, VuiRect* placement_area, float parent_inne
 	// restore the parent's fill_portion_width/height
 	_vui.build.fill_portion_width = parent_fill_portion_width;
 	_vui.build.fill_portion_height = parent_fill_portion_height;
+
+	if (ctrl->flags & _VuiCtrlFlags_is_cache) {
+		_vui_cache_layout_store(ctrl, placement_area, parent_inner_width, parent_inner_height);
+	}
+}
+
+static void _vui_ctrl_translate_children(VuiCtrl* ctrl, VuiVec2 offset) {
+	VuiCtrl* child = NULL;
+	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; child_id = child->sibling_next_id) {
+		child = vui_ctrl_get(child_id);
+		child->rect.left += offset.x;
+		child->rect.right += offset.x;
+		child->rect.top += offset.y;
+		child->rect.bottom += offset.y;
+		if (child->flags & _VuiCtrlFlags_is_cache) {
+			_VuiCache* cache = _vui_cache_get(child);
+			cache->rect.left += offset.x;
+			cache->rect.right += offset.x;
+			cache->rect.top += offset.y;
+			cache->rect.bottom += offset.y;
+		}
+		_vui_ctrl_translate_children(child, offset);
+	}
+}
+
+//
+// returns vui_true if the children of the cache already have their final rectangles.
+// this happens when the layout was skipped, so they have been moved to where the cache now is.
+static VuiBool _vui_cache_layout_finalize(VuiCtrl* ctrl) {
+	_VuiCache* cache = _vui_cache_get(ctrl);
+	VuiBool is_skipped = (ctrl->flags & _VuiCtrlFlags_is_cache_layout_skipped) != 0;
+
+	if (is_skipped && cache->children_layout_idx != cache->skipped_layout_idx) {
+		//
+		// the layout that was skipped last is not the one the children hold.
+		// so lay them out again, the rectangle of the cache has already been finalized so keep it.
+		_VuiCacheLayout* layout = &cache->layouts[cache->skipped_layout_idx];
+		VuiRect rect = ctrl->rect;
+		VuiRect placement_area = layout->placement_area;
+		float parent_fill_portion_width = _vui.build.fill_portion_width;
+		float parent_fill_portion_height = _vui.build.fill_portion_height;
+		_vui.build.fill_portion_width = layout->fill_portion.x;
+		_vui.build.fill_portion_height = layout->fill_portion.y;
+
+		ctrl->flags &= ~_VuiCtrlFlags_is_cache_hit;
+		_vui_layout_ctrls(ctrl, &placement_area, layout->parent_inner_size.x, layout->parent_inner_size.y);
+		ctrl->flags |= _VuiCtrlFlags_is_cache_hit | _VuiCtrlFlags_is_laid_out;
+
+		_vui.build.fill_portion_width = parent_fill_portion_width;
+		_vui.build.fill_portion_height = parent_fill_portion_height;
+		ctrl->rect = rect;
+	}
+
+	VuiBool is_children_final = is_skipped && cache->is_layout_absolute;
+	VuiVec2 offset = VuiVec2_init(ctrl->rect.left - cache->rect.left, ctrl->rect.top - cache->rect.top);
+	cache->rect = ctrl->rect;
+	cache->is_layout_absolute = vui_true;
+	if (!is_children_final) return vui_false;
+
+	if (offset.x != 0.f || offset.y != 0.f) {
+		_vui_ctrl_translate_children(ctrl, offset);
+	}
+	return vui_true;
 }
 
 void _vui_layout_ctrls_finalize(VuiCtrl* ctrl, VuiVec2 offset, float root_width, VuiBool is_popover_root) {
@@ -5343,12 +6753,26 @@ void _vui_layout_ctrls_finalize(VuiCtrl* ctrl, VuiVec2 offset, float root_width,
 
 	//
 	// make the outer rectangle the actual rectangle of the control by applying the margin.
-	VuiThickness* margin = &ctrl->style.margin;
+	VuiThickness* margin = &ctrl->box_style.margin;
 	ctrl->rect.left += margin->left;
 	ctrl->rect.top += margin->top;
 	ctrl->rect.right -= margin->right;
 	ctrl->rect.bottom -= margin->bottom;
 
+	//
+	// the flags that are only used for book keeping do not change how the control is rendered.
+	VuiCtrlFlags render_flags = ctrl->flags & ~(_VuiCtrlFlags_is_new | _VuiCtrlFlags_is_laid_out | _VuiCtrlFlags_is_removing |
+		_VuiCtrlFlags_is_cache_hit | _VuiCtrlFlags_is_cache_layout_skipped | _VuiCtrlFlags_has_old_descendants);
+	_vui_build_hash(&ctrl->id, sizeof(VuiCtrlId));
+	_vui_build_hash(&ctrl->rect, sizeof(VuiRect));
+	_vui_build_hash(&render_flags, sizeof(VuiCtrlFlags));
+	_vui_build_hash(&ctrl->scroll_offset, sizeof(VuiVec2));
+
+	if (ctrl->flags & _VuiCtrlFlags_is_cache) {
+		if (_vui_cache_layout_finalize(ctrl))
+			return;
+	}
+
 	VuiCtrl* child = NULL;
 	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; child_id = child->sibling_next_id) {
 		child = vui_ctrl_get(child_id);
@@ -5419,27 +6843,52 @@ void vui_dump_ctrls(VuiCtrl* root_ctrl) {
 
 #endif // VUI_DEBUG_CTRL_LAYOUT
 
-void _vui_ctrl_dealloc_children(VuiCtrl* ctrl) {
-	VuiCtrl* child = NULL;
+void _vui_ctrl_dealloc_subtree_unfocused(VuiCtrl* ctrl) {
 	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; ) {
-		child = vui_ctrl_get(child_id);
-		_vui_ctrl_dealloc_children(child);
+		VuiCtrl* child = vui_ctrl_get(child_id);
+		//
+		// get the next sibling before the child is deallocated.
 		child_id = child->sibling_next_id;
-		_vui_ctrl_dealloc(child->id);
+		_vui_ctrl_dealloc_subtree_unfocused(child);
 	}
+	_vui_ctrl_dealloc_unfocused(ctrl->id);
 }
 
+//
+// deallocates the control and all of it's descendants.
+// the focuses are checked once by walking up from the focused controls,
+// instead of checking every control that is deallocated.
+void _vui_ctrl_dealloc_subtree(VuiCtrl* ctrl) {
+	_VuiWindow* w = &_vui.windows[_vui.focused_window_id];
+	VuiCtrlId ctrl_id = ctrl->id;
+	if (_vui.mouse_focused_ctrl_id == ctrl_id || _vui_ctrl_is_descendant(_vui.mouse_focused_ctrl_id, ctrl_id)) {
+		_vui_ctrl_set_mouse_focused(0);
+	}
+	if (_vui.mouse_scroll_focused_ctrl_id == ctrl_id || _vui_ctrl_is_descendant(_vui.mouse_scroll_focused_ctrl_id, ctrl_id)) {
+		_vui_ctrl_set_mouse_scroll_focused(0);
+	}
+	if (w->focused_ctrl_id == ctrl_id || _vui_ctrl_is_descendant(w->focused_ctrl_id, ctrl_id)) {
+		vui_ctrl_set_focused(0);
+	}
+
+	_vui_ctrl_dealloc_subtree_unfocused(vui_ctrl_get(ctrl_id));
+}
+
+//
+// only visits the controls that were flagged with _VuiCtrlFlags_has_old_descendants in vui_ctrl_end.
 void _vui_remove_old_ctrls(VuiCtrl* ctrl) {
+	VuiBool has_old_children = ctrl->children_touched_count != ctrl->children_count;
 	VuiCtrl* child = NULL;
 	for (VuiCtrlId child_id = ctrl->child_first_id; child_id;) {
 		child = vui_ctrl_get(child_id);
  		child_id = child->sibling_next_id;
-		if (child->last_frame_idx != _vui.build.frame_idx) {
+		if (has_old_children && child->last_frame_idx != _vui.build.frame_idx) {
 			child->rect = VuiRect_zero;
-			_vui_ctrl_dealloc_children(child);
 			_vui_ctrl_unlink(child);
-			_vui_ctrl_dealloc(child->id);
-		} else {
+			_vui_ctrl_dealloc_subtree(child);
+		} else if ((child->flags & _VuiCtrlFlags_has_old_descendants) && !(child->flags & _VuiCtrlFlags_is_cache_hit)) {
+			//
+			// the children of a cache that was not rebuilt are kept alive.
 			_vui_remove_old_ctrls(child);
 		}
 	}
@@ -5452,7 +6901,9 @@ void vui_window_end() {
 	vui_assert(root->parent_id == 0, "cannot end the window without ending all of it's child controls");
 	vui_ctrl_end();
 
-	_vui_remove_old_ctrls(root);
+	if (root->flags & _VuiCtrlFlags_has_old_descendants) {
+		_vui_remove_old_ctrls(root);
+	}
 
 	float width = root->attributes.width;
 	float height = root->attributes.height;
@@ -5561,26 +7012,273 @@ CONTINUE: {}
 	vui_dump_ctrls(root);
 #endif
 
+	_vui.build.w->build_hash = _vui.build.is_render_forced ? 0 : _vui.build.hash;
 	_vui.build.w = NULL;
 }
 
+void vui_window_invalidate_render() {
+	vui_assert(_vui.build.w != NULL, "vui_window_invalidate_render must be called between vui_window_start and vui_window_end");
+	_vui.build.is_render_forced = vui_true;
+}
+
+void vui_invalidate_renders() {
+	vui_assert(_vui_render_state == NULL, "vui_invalidate_renders cannot be called while a window is being rendered");
+	_vui.renders_epoch += 1;
+}
+
+void vui_invalidate_glyphs() {
+	vui_assert(_vui_render_state == NULL, "vui_invalidate_glyphs cannot be called while a window is being rendered");
+	_vui_atomic_add_u32(&_vui_glyphs_epoch, 1);
+}
+
+typedef struct {
+	uint32_t layer_idx;
+	uint32_t cmds_count;
+	uint32_t cmd_indices_count;
+	uint32_t verts_count;
+} _VuiCacheRenderMark;
+
+//
+// writes the vertices of the cache from the last frame, if the cache was not rebuilt and nothing has moved.
+static VuiBool _vui_cache_render_replay(VuiCtrl* ctrl) {
+	if (!(ctrl->flags & _VuiCtrlFlags_is_cache_hit)) return vui_false;
+
+	_VuiCache* cache = _vui_cache_get(ctrl);
+	if (
+		!cache->is_render_valid ||
+		cache->render_built_frame_idx != cache->built_frame_idx ||
+		cache->built_renders_epoch != _vui_renders_epoch() ||
+		memcmp(&cache->render_rect, &ctrl->rect, sizeof(VuiRect)) != 0 ||
+		memcmp(&cache->render_clip_rect, &_vui_render.clip_rect, sizeof(VuiRect)) != 0
+	) {
+		return vui_false;
+	}
+
+	//
+	// the indices of each run are relative to the first vertex of the run.
+	VuiVertex* src_verts = cache->render_verts;
+	VuiVertexIdx* src_indices = cache->render_indices;
+	VuiRect clip_rect = _vui_render.clip_rect;
+	for (uint32_t i = 0; i < VuiStk_count(cache->render_cmds); i += 1) {
+		_VuiCacheRenderCmd* cmd = &cache->render_cmds[i];
+		_vui_render.clip_rect = cmd->clip_rect;
+		VuiRenderWriter w = vui_render_get_writer(cmd->texture_id, cmd->verts_count, cmd->indices_count);
+		if (w.verts == NULL) break;
+
+		memcpy(w.verts, src_verts, cmd->verts_count * sizeof(VuiVertex));
+		for (uint32_t j = 0; j < cmd->indices_count; j += 1) {
+			w.indices[j] = src_indices[j] + w.verts_start_idx;
+		}
+		src_verts += cmd->verts_count;
+		src_indices += cmd->indices_count;
+	}
+	_vui_render.clip_rect = clip_rect;
+	return vui_true;
+}
+
+static _VuiCacheRenderMark _vui_cache_render_mark() {
+	VuiRenderLayer* layer = &_vui_render.w->render_layers[_vui_render.layer_idx];
+	_VuiCacheRenderMark mark = {0};
+	mark.layer_idx = _vui_render.layer_idx;
+	mark.cmds_count = VuiStk_count(layer->cmds);
+	mark.cmd_indices_count = mark.cmds_count ? VuiStk_last(layer->cmds).indices_count : 0;
+	mark.verts_count = VuiStk_count(layer->verts);
+	return mark;
+}
+
+//
+// copies everything rendered since the mark out of the layer, so it can be replayed on a future frame.
+static void _vui_cache_render_record(VuiCtrl* ctrl, _VuiCacheRenderMark* mark, VuiRect clip_rect) {
+	_VuiCache* cache = _vui_cache_get(ctrl);
+	VuiRenderLayer* layer = &_vui_render.w->render_layers[mark->layer_idx];
+	cache->is_render_valid = vui_false;
+	VuiStk_clear(cache->render_cmds);
+	VuiStk_clear(cache->render_verts);
+	VuiStk_clear(cache->render_indices);
+
+	//
+	// the first indices may have been added to the command that was last in the layer before the mark.
+	uint32_t cmd_idx = mark->cmds_count;
+	uint32_t indices_start_idx = VuiStk_count(layer->indices);
+	if (cmd_idx) {
+		VuiRenderCmd* cmd = &layer->cmds[cmd_idx - 1];
+		indices_start_idx = cmd->indices_start_idx + mark->cmd_indices_count;
+		if (cmd->indices_count != mark->cmd_indices_count) {
+			_VuiCacheRenderCmd* dst = VuiStk_push(&cache->render_cmds);
+			vui_ensure_alloc_ok(dst);
+			dst->texture_id = cmd->texture_id;
+			dst->clip_rect = cmd->clip_rect;
+			dst->verts_count = 0;
+			dst->indices_count = cmd->indices_count - mark->cmd_indices_count;
+		}
+	} else if (VuiStk_count(layer->cmds)) {
+		indices_start_idx = layer->cmds[0].indices_start_idx;
+	}
+
+	for (; cmd_idx < VuiStk_count(layer->cmds); cmd_idx += 1) {
+		VuiRenderCmd* cmd = &layer->cmds[cmd_idx];
+		_VuiCacheRenderCmd* dst = VuiStk_push(&cache->render_cmds);
+		vui_ensure_alloc_ok(dst);
+		dst->texture_id = cmd->texture_id;
+		dst->clip_rect = cmd->clip_rect;
+		dst->verts_count = 0;
+		dst->indices_count = cmd->indices_count;
+	}
+
+	//
+	// each run owns the vertices from where it starts up to where the next run starts.
+	uint32_t runs_count = VuiStk_count(cache->render_cmds);
+	uint32_t first_layer_cmd_idx = VuiStk_count(layer->cmds) - runs_count;
+	uint32_t verts_end_idx = VuiStk_count(layer->verts);
+	for (uint32_t i = runs_count; i-- > 0;) {
+		uint32_t verts_start_idx = i == 0 ? mark->verts_count : layer->cmds[first_layer_cmd_idx + i].verts_start_idx;
+		cache->render_cmds[i].verts_count = verts_end_idx - verts_start_idx;
+		verts_end_idx = verts_start_idx;
+	}
+
+	uint32_t verts_count = VuiStk_count(layer->verts) - mark->verts_count;
+	VuiVertex* verts = VuiStk_push_many(&cache->render_verts, verts_count);
+	vui_ensure_alloc_ok(verts);
+	memcpy(verts, &layer->verts[mark->verts_count], verts_count * sizeof(VuiVertex));
+
+	//
+	// store the indices of each run relative to the first vertex of the run,
+	// as the runs may not share a verts_base_idx when they are replayed.
+	uint32_t indices_count = VuiStk_count(layer->indices) - indices_start_idx;
+	VuiVertexIdx* indices = VuiStk_push_many(&cache->render_indices, indices_count);
+	vui_ensure_alloc_ok(indices);
+	uint32_t idx = 0;
+	for (uint32_t i = 0; i < runs_count; i += 1) {
+		VuiRenderCmd* cmd = &layer->cmds[first_layer_cmd_idx + i];
+		uint32_t verts_start_idx = i == 0 ? mark->verts_count : cmd->verts_start_idx;
+		uint32_t offset = verts_start_idx - cmd->verts_base_idx;
+		for (uint32_t j = 0; j < cache->render_cmds[i].indices_count; j += 1, idx += 1) {
+			indices[idx] = layer->indices[indices_start_idx + idx] - offset;
+		}
+	}
+
+	cache->is_render_valid = vui_true;
+	cache->render_built_frame_idx = cache->built_frame_idx;
+	cache->render_rect = ctrl->rect;
+	cache->render_clip_rect = clip_rect;
+}
+
+void _vui_render_add_damage(_VuiWindow* w, VuiRect rect) {
+	if (rect.right <= rect.left || rect.bottom <= rect.top)
+		return;
+
+	//
+	// merge with any rectangle we overlap so the list stays non-overlapping.
+	// merging can make the result overlap rectangles that we have already checked, so start again.
+	for (uint32_t idx = 0; idx < VuiStk_count(w->render.damage_rects);) {
+		VuiRect* other = &w->render.damage_rects[idx];
+		if (VuiRect_intersects(&rect, other)) {
+			rect = VuiRect_union(&rect, other);
+			VuiStk_remove_shift(w->render.damage_rects, idx);
+			idx = 0;
+		} else {
+			idx += 1;
+		}
+	}
+
+	if (VuiStk_count(w->render.damage_rects) == _vui_damage_rects_max) {
+		//
+		// too many to be worth tracking individually, collapse them into one.
+		for (uint32_t idx = 0; idx < VuiStk_count(w->render.damage_rects); idx += 1) {
+			rect = VuiRect_union(&rect, &w->render.damage_rects[idx]);
+		}
+		VuiStk_clear(w->render.damage_rects);
+	}
+
+	VuiRect* dst = VuiStk_push(&w->render.damage_rects);
+	vui_ensure_alloc_ok(dst);
+	*dst = rect;
+}
+
+void _vui_render_add_damage_subtree(VuiCtrl* ctrl) {
+	if (ctrl->render_hash == 0)
+		return;
+
+	_vui_render_add_damage(_vui_render.w, ctrl->render_bounds);
+	ctrl->render_hash = 0;
+
+	VuiCtrl* child = NULL;
+	for (VuiCtrlId child_id = ctrl->child_first_id; child_id; child_id = child->sibling_next_id) {
+		child = vui_ctrl_get(child_id);
+		_vui_render_add_damage_subtree(child);
+	}
+}
+
+//
+// hashes the vertices & textures that have been emitted on the layer since the start indices,
+// and grows the bounds to contain the vertices.
+void _vui_render_hash_ctrl_geometry(uint64_t* hash, VuiRect* bounds, uint32_t layer_idx, uint32_t verts_start_idx, uint32_t cmds_start_idx) {
+	VuiRenderLayer* layer = &_vui_render.w->render_layers[layer_idx];
+	uint32_t verts_count = VuiStk_count(layer->verts) - verts_start_idx;
+	if (verts_count == 0)
+		return;
+
+	VuiVertex* verts = &layer->verts[verts_start_idx];
+	*hash = _vui_hash_64_words((char*)verts, verts_count * sizeof(VuiVertex), *hash);
+	for (uint32_t idx = 0; idx < verts_count; idx += 1) {
+		VuiVec2 pos = VuiVertex_pos(verts[idx]);
+		bounds->left_top = VuiVec2_min(bounds->left_top, pos);
+		bounds->right_bottom = VuiVec2_max(bounds->right_bottom, pos);
+	}
+
+	//
+	// the vertices may have been added to the command that was current when we started.
+	// with scissor clipping, the vertices can stay the same while the clip_rect changes.
+	if (cmds_start_idx) cmds_start_idx -= 1;
+	for (uint32_t idx = cmds_start_idx; idx < VuiStk_count(layer->cmds); idx += 1) {
+		*hash = vui_fnv_hash_64((char*)&layer->cmds[idx].texture_id, sizeof(VuiTextureId), *hash);
+		*hash = vui_fnv_hash_64((char*)&layer->cmds[idx].clip_rect, sizeof(VuiRect), *hash);
+	}
+}
+
 void _vui_render_ctrls(VuiCtrl* ctrl) {
 	VuiCtrlFlags flags = ctrl->flags;
 
-	VuiRect parent_clip_rect = _vui.render.clip_rect;
+	_VuiCacheRenderMark cache_mark;
+	if (flags & _VuiCtrlFlags_is_cache) {
+		if (_vui_cache_render_replay(ctrl))
+			return;
+		cache_mark = _vui_cache_render_mark();
+	}
+
+	VuiRect parent_clip_rect = _vui_render.clip_rect;
 	VuiRect inner_rect = ctrl->rect;
 	if (ctrl->flags & _VuiCtrlFlags_is_popover) {
 		if (!(ctrl->flags & _VuiCtrlFlags_is_popover_open)) {
+			//
+			// whatever the popover covered last time it was open needs to be redrawn.
+			_vui_render_add_damage_subtree(ctrl);
 			return;
 		}
 		vui_render_inc_layer();
-		VuiCtrl* root_ctrl = vui_ctrl_get(_vui.render.w->root_ctrl_id);
-		_vui.render.clip_rect = VuiRect_init(0, 0, root_ctrl->attributes.width, root_ctrl->attributes.height);
+		VuiCtrl* root_ctrl = vui_ctrl_get(_vui_render.w->root_ctrl_id);
+		_vui_render.clip_rect = VuiRect_init(0, 0, root_ctrl->attributes.width, root_ctrl->attributes.height);
 	} else {
-		_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &inner_rect);
+		//
+		// the control and its children are clipped by it's rectangle,
+		// so nothing is visible when it is completely outside of the clip rectangle.
+		if (!VuiRect_intersects(&_vui_render.clip_rect, &inner_rect)) {
+			_vui_render_add_damage_subtree(ctrl);
+			return;
+		}
+		_vui_render.clip_rect = VuiRect_clip(&_vui_render.clip_rect, &inner_rect);
 	}
 
-	const VuiCtrlStyle* style = &ctrl->style;
+	//
+	// hash the geometry this control emits itself (not its children's),
+	// so we can find the areas of the window that have changed since the last render.
+	uint64_t render_hash = vui_fnv_hash_64_initial;
+	VuiRect render_bounds = VuiRect_init(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	uint32_t layer_idx = _vui_render.layer_idx;
+	uint32_t verts_start_idx = VuiStk_count(_vui_render.w->render_layers[layer_idx].verts);
+	uint32_t cmds_start_idx = VuiStk_count(_vui_render.w->render_layers[layer_idx].cmds);
+
+	const VuiCtrlBoxStyle* style = &ctrl->box_style;
 
 	float border_width_half = style->border_width / 2.0;
 	if (style->bg_color.a) {
@@ -5606,14 +7304,14 @@ void _vui_render_ctrls(VuiCtrl* ctrl) {
 		inner_rect.top += style->border_width;
 		inner_rect.bottom -= style->border_width;
 		inner_rect.right -= style->border_width;
-		_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &inner_rect);
+		_vui_render.clip_rect = VuiRect_clip(&_vui_render.clip_rect, &inner_rect);
 	}
 
 	inner_rect.left += style->padding.left;
 	inner_rect.top += style->padding.top;
 	inner_rect.bottom -= style->padding.bottom;
 	inner_rect.right -= style->padding.right;
-	_vui.render.clip_rect = VuiRect_clip(&_vui.render.clip_rect, &inner_rect);
+	_vui_render.clip_rect = VuiRect_clip(&_vui_render.clip_rect, &inner_rect);
 
 	float interp_ratio = 1.0;
 	if (ctrl->state_time < ctrl->attributes.style_transition_time) {
@@ -5628,6 +7326,8 @@ void _vui_render_ctrls(VuiCtrl* ctrl) {
 		ctrl->styles[0].pre_animate_fn(ctrl, _vui.build.dt, interp_ratio, ctrl->state_time == _vui.build.dt);
 	}
 
+	_vui_render_hash_ctrl_geometry(&render_hash, &render_bounds, layer_idx, verts_start_idx, cmds_start_idx);
+
 	//
 	// now render the children;
 	//
@@ -5637,24 +7337,229 @@ void _vui_render_ctrls(VuiCtrl* ctrl) {
 		_vui_render_ctrls(child);
 	}
 
+	verts_start_idx = VuiStk_count(_vui_render.w->render_layers[layer_idx].verts);
+	cmds_start_idx = VuiStk_count(_vui_render.w->render_layers[layer_idx].cmds);
 	if (ctrl->styles && ctrl->styles[0].post_animate_fn) {
 		ctrl->styles[0].post_animate_fn(ctrl, _vui.build.dt, interp_ratio, ctrl->state_time == _vui.build.dt);
 	}
+	_vui_render_hash_ctrl_geometry(&render_hash, &render_bounds, layer_idx, verts_start_idx, cmds_start_idx);
 
-	_vui.render.clip_rect = parent_clip_rect;
+	if (ctrl->render_hash != render_hash || memcmp(&ctrl->render_bounds, &render_bounds, sizeof(VuiRect)) != 0) {
+		if (ctrl->render_hash) {
+			_vui_render_add_damage(_vui_render.w, ctrl->render_bounds);
+		}
+		_vui_render_add_damage(_vui_render.w, render_bounds);
+		ctrl->render_hash = render_hash;
+		ctrl->render_bounds = render_bounds;
+	}
+
+	_vui_render.clip_rect = parent_clip_rect;
 	if (ctrl->flags & _VuiCtrlFlags_is_popover) {
 		vui_render_dec_layer();
 	}
+
+	//
+	// popovers render to another layer, so caches that are popovers are never replayed.
+	if ((flags & _VuiCtrlFlags_is_cache) && !(flags & _VuiCtrlFlags_is_popover)) {
+		_vui_cache_render_record(ctrl, &cache_mark, parent_clip_rect);
+	}
 }
 
-VuiWindowRender* vui_window_render(VuiWindowId id, float scale_factor, VuiBool pixel_snapping) {
-	_vui_window_assert_id(id);
+//
+// merges the commands of the layer that share a texture, clip_rect and verts_base_idx, so they are drawn with one draw call.
+// eg. a row of image buttons alternates between the image and the glyph texture.
+// a command is moved back to join an earlier batch only when it does not overlap anything that is drawn in between,
+// so the result looks the same. the batches keep the order of their first command.
+static void _vui_render_layer_merge_cmds(VuiRenderLayer* layer) {
+	uint32_t cmds_count = VuiStk_count(layer->cmds);
+	if (vui_render_cmd_merge_lookback == 0 || cmds_count < 3) return;
+
+	VuiStk_clear(_vui_render.merge_batches);
+	VuiStk_clear(_vui_render.merge_next_cmd_idxs);
+	uint32_t* next_cmd_idxs = VuiStk_push_many(&_vui_render.merge_next_cmd_idxs, cmds_count);
+	vui_ensure_alloc_ok(next_cmd_idxs);
+
+	VuiBool is_merged = vui_false;
+	for (uint32_t cmd_idx = 0; cmd_idx < cmds_count; cmd_idx += 1) {
+		VuiRenderCmd* cmd = &layer->cmds[cmd_idx];
+		next_cmd_idxs[cmd_idx] = UINT32_MAX;
 
-	if (pixel_snapping)
-		_vui.flags |= _VuiFlags_pixel_snapping;
+		//
+		// the vertices of a command come after the ones of the command before it.
+		uint32_t verts_end_idx = cmd_idx + 1 < cmds_count ? layer->cmds[cmd_idx + 1].verts_start_idx : VuiStk_count(layer->verts);
+		VuiRect bounds = VuiRect_init(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (uint32_t idx = cmd->verts_start_idx; idx < verts_end_idx; idx += 1) {
+			VuiVec2 pos = VuiVertex_pos(layer->verts[idx]);
+			bounds.left_top = VuiVec2_min(bounds.left_top, pos);
+			bounds.right_bottom = VuiVec2_max(bounds.right_bottom, pos);
+		}
 
-	_VuiWindow* w = &_vui.windows[id];
-	_vui.render.clip_rect = VuiRect_init_v2(VuiVec2_zero, w->size);
+		//
+		// look back through the batches for one that uses the same texture and clip rect.
+		// stop at the first one we overlap, as we cannot be drawn before it.
+		uint32_t batches_count = VuiStk_count(_vui_render.merge_batches);
+		uint32_t lookback_end = batches_count > vui_render_cmd_merge_lookback ? batches_count - vui_render_cmd_merge_lookback : 0;
+		_VuiRenderBatch* batch = NULL;
+		for (uint32_t batch_idx = batches_count; batch_idx-- > lookback_end;) {
+			_VuiRenderBatch* b = &_vui_render.merge_batches[batch_idx];
+			VuiRenderCmd* batch_cmd = &layer->cmds[b->first_cmd_idx];
+			if (
+				batch_cmd->texture_id == cmd->texture_id &&
+				batch_cmd->verts_base_idx == cmd->verts_base_idx &&
+				memcmp(&batch_cmd->clip_rect, &cmd->clip_rect, sizeof(VuiRect)) == 0
+			) {
+				batch = b;
+				break;
+			}
+			if (VuiRect_intersects(&b->bounds, &bounds)) {
+				break;
+			}
+		}
+
+		if (batch) {
+			next_cmd_idxs[batch->last_cmd_idx] = cmd_idx;
+			batch->last_cmd_idx = cmd_idx;
+			batch->bounds = VuiRect_union(&batch->bounds, &bounds);
+			batch->indices_count += cmd->indices_count;
+			is_merged = vui_true;
+		} else {
+			batch = VuiStk_push(&_vui_render.merge_batches);
+			vui_ensure_alloc_ok(batch);
+			batch->bounds = bounds;
+			batch->first_cmd_idx = cmd_idx;
+			batch->last_cmd_idx = cmd_idx;
+			batch->indices_count = cmd->indices_count;
+		}
+	}
+
+	if (!is_merged) return;
+
+	//
+	// now write out a command for each batch, with the indices of its commands one after another.
+	// the vertices do not move, so the indices do not need to change.
+	uint32_t batches_count = VuiStk_count(_vui_render.merge_batches);
+	VuiStk_clear(_vui_render.merge_cmds);
+	VuiStk_clear(_vui_render.merge_indices);
+	VuiRenderCmd* dst_cmds = VuiStk_push_many(&_vui_render.merge_cmds, batches_count);
+	vui_ensure_alloc_ok(dst_cmds);
+	VuiVertexIdx* dst_indices = VuiStk_push_many(&_vui_render.merge_indices, VuiStk_count(layer->indices));
+	vui_ensure_alloc_ok(dst_indices);
+
+	uint32_t indices_start_idx = 0;
+	for (uint32_t batch_idx = 0; batch_idx < batches_count; batch_idx += 1) {
+		_VuiRenderBatch* batch = &_vui_render.merge_batches[batch_idx];
+		VuiRenderCmd* dst = &dst_cmds[batch_idx];
+		*dst = layer->cmds[batch->first_cmd_idx];
+		dst->indices_start_idx = indices_start_idx;
+		dst->indices_count = batch->indices_count;
+
+		for (uint32_t cmd_idx = batch->first_cmd_idx; cmd_idx != UINT32_MAX; cmd_idx = next_cmd_idxs[cmd_idx]) {
+			VuiRenderCmd* cmd = &layer->cmds[cmd_idx];
+			memcpy(&dst_indices[indices_start_idx], &layer->indices[cmd->indices_start_idx], cmd->indices_count * sizeof(VuiVertexIdx));
+			indices_start_idx += cmd->indices_count;
+		}
+	}
+
+	//
+	// swap the merged arrays in to the layer, the old ones are kept as scratch space for the next time.
+	VuiStk(VuiRenderCmd) cmds = layer->cmds;
+	layer->cmds = _vui_render.merge_cmds;
+	_vui_render.merge_cmds = cmds;
+	VuiStk(VuiVertexIdx) indices = layer->indices;
+	layer->indices = _vui_render.merge_indices;
+	_vui_render.merge_indices = indices;
+}
+
+//
+// scales the vertices by the scale_factor and rounds their positions to the nearest pixel when pixel_snapping.
+// the positions of the default vertex are done two at a time with SSE2 or NEON when they are available.
+// rounding is to nearest even in all paths, so the result does not depend on which one is used.
+static void _vui_render_scale_and_snap_verts(VuiVertex* verts, uint32_t verts_count, float scale_factor, VuiBool pixel_snapping) {
+#if _vui_vertex_is_default
+	uint32_t idx = 0;
+#if _vui_sse2
+	__m128 scale = _mm_set1_ps(scale_factor);
+	for (; idx + 2 <= verts_count; idx += 2) {
+		__m128 pos = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&verts[idx].pos);
+		pos = _mm_loadh_pi(pos, (const __m64*)&verts[idx + 1].pos);
+		pos = _mm_mul_ps(pos, scale);
+		if (pixel_snapping) {
+			pos = _mm_cvtepi32_ps(_mm_cvtps_epi32(pos));
+		}
+		_mm_storel_pi((__m64*)&verts[idx].pos, pos);
+		_mm_storeh_pi((__m64*)&verts[idx + 1].pos, pos);
+	}
+#elif _vui_neon
+	float32x4_t scale = vdupq_n_f32(scale_factor);
+	for (; idx + 2 <= verts_count; idx += 2) {
+		float32x4_t pos = vcombine_f32(vld1_f32(&verts[idx].pos.x), vld1_f32(&verts[idx + 1].pos.x));
+		pos = vmulq_f32(pos, scale);
+		if (pixel_snapping) {
+			pos = vrndnq_f32(pos);
+		}
+		vst1_f32(&verts[idx].pos.x, vget_low_f32(pos));
+		vst1_f32(&verts[idx + 1].pos.x, vget_high_f32(pos));
+	}
+#endif
+	for (; idx < verts_count; idx += 1) {
+		verts[idx].pos.x *= scale_factor;
+		verts[idx].pos.y *= scale_factor;
+		if (pixel_snapping) {
+			VuiVertex_snap_pos(verts[idx]);
+		}
+	}
+
+#if VUI_SDF_SHAPES
+	//
+	// the shape is left unsnapped, the fragment shader anti-aliases its edges.
+	if (scale_factor != 1.0) {
+		for (idx = 0; idx < verts_count; idx += 1) {
+			VuiVertex* v = &verts[idx];
+			v->sdf_center = VuiVec2_mul_scalar(v->sdf_center, scale_factor);
+			v->sdf_half_size = VuiVec2_mul_scalar(v->sdf_half_size, scale_factor);
+			v->sdf_radius *= scale_factor;
+			v->sdf_border_width *= scale_factor;
+		}
+	}
+#endif // VUI_SDF_SHAPES
+
+#else // _vui_vertex_is_default
+	for (uint32_t idx = 0; idx < verts_count; idx += 1) {
+		if (scale_factor != 1.0) {
+			VuiVertex_scale_pos(verts[idx], scale_factor);
+		}
+		if (pixel_snapping) {
+			VuiVertex_snap_pos(verts[idx]);
+		}
+	}
+#endif // _vui_vertex_is_default
+}
+
+static VuiWindowRender* _vui_window_render(_VuiWindow* w, float scale_factor, VuiBool pixel_snapping) {
+
+	//
+	// nothing that the controls render from has changed since the last render, so it can be reused.
+	if (
+		w->build_hash && w->build_hash == w->render_build_hash && w->render_renders_epoch == _vui_renders_epoch() &&
+		w->render_size.x == w->size.x && w->render_size.y == w->size.y &&
+		w->render_scale_factor == scale_factor && w->render_pixel_snapping == pixel_snapping
+	) {
+		VuiStk_clear(w->render.damage_rects);
+		VuiStk_clear(w->removed_ctrl_bounds);
+		return &w->render;
+	}
+	w->render_build_hash = w->build_hash;
+	w->render_renders_epoch = _vui_renders_epoch();
+	VuiBool is_pixel_snapping_changed = w->render_pixel_snapping != pixel_snapping;
+	w->render_pixel_snapping = pixel_snapping;
+
+	_vui_render.clip_rect = VuiRect_init_v2(VuiVec2_zero, w->size);
+
+	VuiStk_clear(w->render.damage_rects);
+	for (uint32_t idx = 0; idx < VuiStk_count(w->removed_ctrl_bounds); idx += 1) {
+		_vui_render_add_damage(w, w->removed_ctrl_bounds[idx]);
+	}
+	VuiStk_clear(w->removed_ctrl_bounds);
 
 	VuiStk(VuiRenderLayer) layers = w->render_layers;
 	uint32_t layers_count = VuiStk_count(layers);
@@ -5667,43 +7572,86 @@ VuiWindowRender* vui_window_render(VuiWindowId id, float scale_factor, VuiBool p
 
 	if (w->root_ctrl_id == 0) return NULL;
 
-	_vui.render.layer_idx = -1;
-	_vui.render.w = w;
+	_vui_render.layer_idx = -1;
+	_vui_render.w = w;
 	vui_render_inc_layer();
 
 	_vui_render_ctrls(vui_ctrl_get(w->root_ctrl_id));
 
-	VuiStk_clear(w->render.indices);
-	VuiStk_clear(w->render.verts);
-	VuiStk_clear(w->render.cmds);
+	//
+	// everything needs redrawing when the window is rendered for the first time or resized.
+	if (w->render_size.x != w->size.x || w->render_size.y != w->size.y || w->render_scale_factor != scale_factor || is_pixel_snapping_changed) {
+		VuiStk_clear(w->render.damage_rects);
+		VuiRect* rect = VuiStk_push(&w->render.damage_rects);
+		vui_ensure_alloc_ok(rect, NULL);
+		*rect = VuiRect_init_v2(VuiVec2_zero, w->size);
+		w->render_size = w->size;
+		w->render_scale_factor = scale_factor;
+	}
+
+	if (scale_factor != 1.0 || pixel_snapping) {
+		for (uint32_t idx = 0; idx < VuiStk_count(w->render.damage_rects); idx += 1) {
+			VuiRect* rect = &w->render.damage_rects[idx];
+			rect->left_top = VuiVec2_mul_scalar(rect->left_top, scale_factor);
+			rect->right_bottom = VuiVec2_mul_scalar(rect->right_bottom, scale_factor);
+			//
+			// snapping can move a vertex by up to half a pixel, so grow the rect out to whole pixels.
+			if (pixel_snapping) {
+				rect->left = floorf(rect->left);
+				rect->top = floorf(rect->top);
+				rect->right = ceilf(rect->right);
+				rect->bottom = ceilf(rect->bottom);
+			}
+		}
+	}
 
 	uint64_t hash = vui_fnv_hash_64_initial;
 	layers = w->render_layers;
 	layers_count = VuiStk_count(layers);
 	for (int idx = 0; idx < layers_count; idx += 1) {
 		VuiRenderLayer* layer = &layers[idx];
+		_vui_render_layer_merge_cmds(layer);
+		if (scale_factor != 1.0 || pixel_snapping) {
+			_vui_render_scale_and_snap_verts(layer->verts, VuiStk_count(layer->verts), scale_factor, pixel_snapping);
+		}
 		if (scale_factor != 1.0) {
-			VuiVertex* verts = layer->verts;
-			for (int v_idx = 0; v_idx < VuiStk_count(layer->verts); v_idx += 1) {
-				VuiVertex_scale_pos(verts[v_idx], scale_factor);
+			for (uint32_t i = 0; i < VuiStk_count(layer->cmds); i += 1) {
+				VuiRenderCmd* cmd = &layer->cmds[i];
+				cmd->clip_rect.left_top = VuiVec2_mul_scalar(cmd->clip_rect.left_top, scale_factor);
+				cmd->clip_rect.right_bottom = VuiVec2_mul_scalar(cmd->clip_rect.right_bottom, scale_factor);
 			}
 		}
-		hash = vui_fnv_hash_64((char*)layer->cmds, VuiStk_count(layer->cmds) * sizeof(VuiRenderCmd), hash);
-		hash = vui_fnv_hash_64((char*)layer->verts, VuiStk_count(layer->verts) * sizeof(VuiVertex), hash);
-		hash = vui_fnv_hash_64((char*)layer->indices, VuiStk_count(layer->indices) * sizeof(VuiVertexIdx), hash);
+		hash = _vui_hash_64_lanes((char*)layer->cmds, VuiStk_count(layer->cmds) * sizeof(VuiRenderCmd), hash);
+		hash = _vui_hash_64_lanes((char*)layer->verts, VuiStk_count(layer->verts) * sizeof(VuiVertex), hash);
+		hash = _vui_hash_64_lanes((char*)layer->indices, VuiStk_count(layer->indices) * sizeof(VuiVertexIdx), hash);
+
+		//
+		// the first layer holds nearly everything, so rather than copying it, swap its arrays with the ones
+		// from the last render. those get cleared and reused by the first layer next render.
+		if (idx == 0) {
+			VuiRenderLayer last = { .cmds = w->render.cmds, .verts = w->render.verts, .indices = w->render.indices };
+			w->render.cmds = layer->cmds;
+			w->render.verts = layer->verts;
+			w->render.indices = layer->indices;
+			layer->cmds = last.cmds;
+			layer->verts = last.verts;
+			layer->indices = last.indices;
+			continue;
+		}
+
 		uint32_t old_vertices_count = VuiStk_count(w->render.verts);
 		uint32_t old_indices_count = VuiStk_count(w->render.indices);
 
 		//
-		// flattern all these layers into one big array.
+		// append the other layers after the first. the indices are left relative to the layer
+		// and the commands point at where the layer's vertices start instead.
 		VuiRenderCmd* cmds = VuiStk_push_many(&w->render.cmds, VuiStk_count(layer->cmds));
 		vui_ensure_alloc_ok(cmds, NULL);
 		memcpy(cmds, layer->cmds, VuiStk_count(layer->cmds) * sizeof(VuiRenderCmd));
-		if (old_vertices_count) {
-			for (uint32_t i = 0; i < VuiStk_count(layer->cmds); i += 1) {
-				cmds[i].verts_start_idx += old_vertices_count;
-				cmds[i].indices_start_idx += old_indices_count;
-			}
+		for (uint32_t i = 0; i < VuiStk_count(layer->cmds); i += 1) {
+			cmds[i].verts_base_idx += old_vertices_count;
+			cmds[i].verts_start_idx += old_vertices_count;
+			cmds[i].indices_start_idx += old_indices_count;
 		}
 
 		VuiVertex* verts = VuiStk_push_many(&w->render.verts, VuiStk_count(layer->verts));
@@ -5713,18 +7661,30 @@ VuiWindowRender* vui_window_render(VuiWindowId id, float scale_factor, VuiBool p
 		VuiVertexIdx* indices = VuiStk_push_many(&w->render.indices, VuiStk_count(layer->indices));
 		vui_ensure_alloc_ok(indices, NULL);
 		memcpy(indices, layer->indices, VuiStk_count(layer->indices) * sizeof(VuiVertexIdx));
-		if (old_vertices_count) {
-			for (uint32_t i = 0; i < VuiStk_count(layer->indices); i += 1) {
-				indices[i] += old_vertices_count;
-			}
-		}
 	}
 	w->render.hash = hash;
-	_vui.render.w = NULL;
+	_vui_render.w = NULL;
 
 	return &w->render;
 }
 
+VuiWindowRender* vui_window_render(VuiWindowId id, float scale_factor, VuiBool pixel_snapping) {
+	_vui_window_assert_id(id);
+	_VuiWindow* w = &_vui.windows[id];
+
+	//
+	// the render state is the window's own, so it is safe to render another window on a different thread.
+	_VuiRenderState* prev_render_state = _vui_render_state;
+	_vui_render_state = &w->render_state;
+	VuiWindowRender* render = _vui_window_render(w, scale_factor, pixel_snapping);
+	_vui_render_state = prev_render_state;
+	return render;
+}
+
+VuiBool vui_window_is_rendering() {
+	return _vui_render_state != NULL;
+}
+
 void vui_window_set_mouse_focused(VuiWindowId id) {
 	_vui_window_assert_id(id);
 	_vui.mouse_focused_window_id = id;
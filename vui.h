@@ -18,6 +18,51 @@
 #define VUI_DEBUG_CTRL_LAYOUT 1
 
 #define vui_debug_ctrl_layout_dump_file_path "/tmp/vui_ctrls"
+
+//
+// when enabled, rounded rectangles, circles and borders are rendered as a single quad
+// that carries the shape in its vertices. the fragment shader then fills it using a signed distance function.
+// see VuiVertex_init_sdf and vui_opengl_sdf_fragment_shader_src in backends/vui_opengl.c
+#ifndef VUI_SDF_SHAPES
+#define VUI_SDF_SHAPES 0
+#endif
+
+//
+// the distance in pixels an SDF quad extends past its shape, so the anti-aliased edge fits inside of it.
+#ifndef vui_sdf_aa_width
+#define vui_sdf_aa_width 1.0f
+#endif
+//
+// when enabled, the default VuiVertex is 12 bytes instead of 20.
+// the position is fixed point with vui_compact_vertex_pos_frac_bits bits below the pixel,
+// the uv is 16 bits per component and glyphs are flagged in the lowest bit of the uv instead of negating it.
+// see vui_opengl_compact_vertex_shader_src in backends/vui_opengl.c
+#ifndef VUI_COMPACT_VERTEX
+#define VUI_COMPACT_VERTEX 0
+#endif
+
+//
+// the positions of the compact vertex are in 1 / (1 << vui_compact_vertex_pos_frac_bits) pixels.
+// so they reach -32768 >> vui_compact_vertex_pos_frac_bits to 32767 >> vui_compact_vertex_pos_frac_bits pixels
+// after the scale_factor, and are clamped to that.
+#ifndef vui_compact_vertex_pos_frac_bits
+#define vui_compact_vertex_pos_frac_bits 2
+#endif
+
+//
+// when a render command is started, it can be moved back to join an earlier command with the same texture
+// if nothing in between overlaps it. this is how many commands back it looks, 0 turns the merging off.
+#ifndef vui_render_cmd_merge_lookback
+#define vui_render_cmd_merge_lookback 32
+#endif
+
+//
+// how many text sizes are remembered between frames, so unchanged labels do not call the position_text_fn to be measured.
+// the least recently used size is dropped when it is full, 0 turns the cache off. see VuiSetup.text_size_cache.
+#ifndef vui_text_size_cache_cap
+#define vui_text_size_cache_cap 4096
+#endif
+
 #define vui_text_box_select_scroll_amount 4.0f
 
 #ifndef VuiCtrlStyle_max_colors
@@ -424,6 +469,7 @@ VuiVec2 VuiRect_center(const VuiRect* r);
 VuiRect VuiRect_clip(const VuiRect* a, const VuiRect* b);
 VuiVec2 VuiRect_clip_pt(const VuiRect* rect, VuiVec2 pt);
 VuiBool VuiRect_intersects(const VuiRect* a, const VuiRect* b);
+VuiRect VuiRect_union(const VuiRect* a, const VuiRect* b);
 VuiBool VuiRect_intersects_pt(const VuiRect* r, VuiVec2 pt);
 
 typedef uint32_t VuiFontId;
@@ -732,6 +778,10 @@ enum {
 	_VuiCtrlFlags_is_popover_open = 0x80000,
 	_VuiCtrlFlags_is_canvas = 0x100000,
 	_VuiCtrlFlags_is_removing = 0x200000,
+	_VuiCtrlFlags_is_cache = 0x400000,
+	_VuiCtrlFlags_is_cache_hit = 0x800000,
+	_VuiCtrlFlags_is_cache_layout_skipped = 0x1000000,
+	_VuiCtrlFlags_has_old_descendants = 0x2000000,
 };
 
 typedef uint8_t VuiLayoutType;
@@ -876,6 +926,19 @@ struct VuiCanvasItem {
 };
 
 typedef void (*VuiCtrlRenderFn)(VuiCtrl* ctrl, VuiRect* content_rect, float interp_ratio);
+
+//
+// the parts of the interpolated style that the layout, the mouse focus search and the rendering read for every control.
+typedef struct VuiCtrlBoxStyle VuiCtrlBoxStyle;
+struct VuiCtrlBoxStyle {
+	VuiThickness margin;
+	VuiThickness padding;
+	VuiColor bg_color;
+	VuiColor border_color;
+	float border_width;
+	float radius;
+};
+
 struct VuiCtrl {
 	VuiCtrlId id;
 	VuiCtrlId parent_id;
@@ -886,7 +949,13 @@ struct VuiCtrl {
 	VuiCtrlId scroll_content_id;
 	VuiCtrlSibId sib_id;
 	uint32_t last_frame_idx;
+	uint32_t children_count;
+	uint32_t children_touched_count; // the number of children that have been started this frame
 	VuiRect rect;
+	//
+	// a copy of the box fields of the interpolated style in VuiCtrlCold, so walking the tree does not have to touch it.
+	// this is updated whenever the style is interpolated. it is next to the rect as they are read together.
+	VuiCtrlBoxStyle box_style;
 	VuiCtrlStateFlags state_flags;
     VuiLayoutType layout_type;
 	VuiFocusState focus_state;
@@ -899,8 +968,13 @@ struct VuiCtrl {
 	VuiCtrlState prev_state;
 
 	const VuiCtrlStyle* styles; // this is an array to be index with VuiCtrlState
-	VuiCtrlStyle prev_style;
-	VuiCtrlStyle style;
+
+	//
+	// a hash and the bounding box of the vertices the control rendered itself on the last frame.
+	// these are compared against the next frame to find the damaged rectangles.
+	// a render_hash of 0 means the control was not rendered.
+	uint64_t render_hash;
+	VuiRect render_bounds;
 
 	union {
 		struct {
@@ -915,17 +989,34 @@ struct VuiCtrl {
 		struct {
 			VuiVec2 scroll_view_size;
 		};
+		struct {
+			uint32_t list_view_row_count;
+			uint32_t list_view_end_idx;
+			float list_view_row_height;
+		};
 		struct {
 			VuiCtrlId popover_target_ctrl_id;
 			VuiBool* popover_is_open_ptr;
 		};
 		VuiStk(VuiCanvasItem) canvas_items;
+		uint32_t cache_id;
 	};
 
+	VuiCtrlAttrs attributes;
+};
+
+//
+// the parts of a control that are only needed when it is styled, animated or rendered.
+// these are stored apart from the VuiCtrl so walking the control tree
+// does not have to pull them into the cache. use vui_ctrl_cold to get them.
+// these used to be the style, prev_style, animate_aux and prev_animate_aux fields of VuiCtrl.
+typedef struct VuiCtrlCold VuiCtrlCold;
+struct VuiCtrlCold {
+	VuiCtrlStyle prev_style;
+	VuiCtrlStyle style;
+
 	VuiCtrlAnimateAux prev_animate_aux;
 	VuiCtrlAnimateAux animate_aux;
-
-	VuiCtrlAttrs attributes;
 };
 
 // ===========================================================================================
@@ -1046,6 +1137,10 @@ typedef struct {
 	VuiCtrlStyle scroll_bar_slider[VuiCtrlState_COUNT];
 	VuiCtrlStyle popover[VuiCtrlState_COUNT];
 } VuiStyleSheet;
+//
+// the default styles, there is only one of these for the whole process and it is shared by every VuiContext.
+// vui_init sets the font_id of text_header and text_menu to VuiSetup.default_font_id, vui_context_create does not touch it.
+// so do not change it while any context is building a frame.
 extern VuiStyleSheet vui_ss;
 
 // ===========================================================================================
@@ -1062,14 +1157,102 @@ extern VuiStyleSheet vui_ss;
 
 #ifndef VuiVertexT
 
+#if VUI_COMPACT_VERTEX
+
+#if VUI_SDF_SHAPES
+#error "VUI_SDF_SHAPES needs the float fields of the full VuiVertex, so it cannot be used with VUI_COMPACT_VERTEX"
+#endif
+
+//
+// pos is in fixed point, see vui_compact_vertex_pos_frac_bits.
+// uv is from 0 to 65535 and the lowest bit of uv[0] is set for glyphs, so the u only has 15 bits.
+typedef struct {
+	int16_t pos[2];
+	uint16_t uv[2];
+	VuiColor color;
+} VuiVertexT;
+
+#define _vui_compact_vertex_pos_one ((float)(1 << vui_compact_vertex_pos_frac_bits))
+
+static inline int16_t _VuiVertex_compact_pos(float v) {
+	return (int16_t)rintf(vui_clamp(v, -32768.f, 32767.f));
+}
+
+static inline VuiVertexT _VuiVertex_init_compact(VuiVec2 pos, VuiVec2 uv, VuiColor color, VuiBool is_glyph) {
+	VuiVertexT v;
+	v.pos[0] = _VuiVertex_compact_pos(pos.x * _vui_compact_vertex_pos_one);
+	v.pos[1] = _VuiVertex_compact_pos(pos.y * _vui_compact_vertex_pos_one);
+	v.uv[0] = ((uint16_t)rintf(vui_clamp(uv.x, 0.f, 1.f) * 32767.f) << 1) | (is_glyph ? 1 : 0);
+	v.uv[1] = (uint16_t)rintf(vui_clamp(uv.y, 0.f, 1.f) * 65535.f);
+	v.color = color;
+	return v;
+}
+
+#define VuiVertex_init(pos_, uv_, color_) _VuiVertex_init_compact(pos_, uv_, color_, 0)
+#define VuiVertex_init_glyph(pos_, uv_, color_) _VuiVertex_init_compact(pos_, uv_, color_, 1)
+#define VuiVertex_pos(vertex) VuiVec2_init((vertex).pos[0] / _vui_compact_vertex_pos_one, (vertex).pos[1] / _vui_compact_vertex_pos_one)
+#define VuiVertex_scale_pos(vertex, scale_factor) \
+	(vertex).pos[0] = _VuiVertex_compact_pos((vertex).pos[0] * (scale_factor)); \
+	(vertex).pos[1] = _VuiVertex_compact_pos((vertex).pos[1] * (scale_factor));
+#define VuiVertex_snap_pos(vertex) \
+	(vertex).pos[0] = _VuiVertex_compact_pos(rintf((vertex).pos[0] / _vui_compact_vertex_pos_one) * _vui_compact_vertex_pos_one); \
+	(vertex).pos[1] = _VuiVertex_compact_pos(rintf((vertex).pos[1] / _vui_compact_vertex_pos_one) * _vui_compact_vertex_pos_one);
+#define VuiVertex_debug_fprintf(vertex, file) \
+	fprintf(file, \
+			"\t%u: { pos: [%f, %f], uv: [%u, %u], color: #%.2x%.2x%.2x%.2x }\n", \
+			vert_idx, \
+			vert->pos[0] / _vui_compact_vertex_pos_one, \
+			vert->pos[1] / _vui_compact_vertex_pos_one, \
+			vert->uv[0], \
+			vert->uv[1], \
+			vert->color.r, \
+			vert->color.g, \
+			vert->color.b, \
+			vert->color.a);
+
+#else // VUI_COMPACT_VERTEX
+
+#if VUI_SDF_SHAPES
+
+//
+// sdf_half_size is zero for every vertex that is not part of an SDF quad.
+// sdf_border_width is zero when the shape is filled.
+typedef struct {
+	VuiVec2 pos;
+	VuiVec2 uv;
+	VuiColor color;
+	VuiVec2 sdf_center;
+	VuiVec2 sdf_half_size;
+	float sdf_radius;
+	float sdf_border_width;
+} VuiVertexT;
+
+#define VuiVertex_init_sdf(pos_, color_, center_, half_size_, radius_, border_width_) \
+	(VuiVertexT) { .pos = pos_, .color = color_, .sdf_center = center_, .sdf_half_size = half_size_, .sdf_radius = radius_, .sdf_border_width = border_width_ }
+#define VuiVertex_scale_pos(vertex, scale_factor) \
+	(vertex).pos.x *= scale_factor; (vertex).pos.y *= scale_factor; \
+	(vertex).sdf_center.x *= scale_factor; (vertex).sdf_center.y *= scale_factor; \
+	(vertex).sdf_half_size.x *= scale_factor; (vertex).sdf_half_size.y *= scale_factor; \
+	(vertex).sdf_radius *= scale_factor; (vertex).sdf_border_width *= scale_factor;
+
+#else // VUI_SDF_SHAPES
+
 typedef struct {
 	VuiVec2 pos;
 	VuiVec2 uv;
 	VuiColor color;
 } VuiVertexT;
 
-#define VuiVertex_init(pos_, uv_, color_) (VuiVertexT) { .pos = pos_, .uv = uv_, .color = color_ }
 #define VuiVertex_scale_pos(vertex, scale_factor) (vertex).pos.x *= scale_factor; (vertex).pos.y *= scale_factor;
+
+#endif // VUI_SDF_SHAPES
+
+#define VuiVertex_init(pos_, uv_, color_) (VuiVertexT) { .pos = pos_, .uv = uv_, .color = color_ }
+#define VuiVertex_pos(vertex) (vertex).pos
+#define VuiVertex_snap_pos(vertex) (vertex).pos.x = rintf((vertex).pos.x); (vertex).pos.y = rintf((vertex).pos.y);
+//
+// lets vui.c scale and snap the positions of the default vertex with SIMD.
+#define _vui_vertex_is_default 1
 #define VuiVertex_debug_fprintf(vertex, file) \
 	fprintf(file, \
 			"\t%u: { pos: [%f, %f], uv: [%f, %f], color: #%.2x%.2x%.2x%.2x }\n", \
@@ -1083,30 +1266,62 @@ typedef struct {
 			vert->color.b, \
 			vert->color.a);
 
+#endif // VUI_COMPACT_VERTEX
+
 #else // VuiVertexT
 
 #ifndef VuiVertex_init
 #error "VuiVertex_init must be defined when defining a custom VuiVertexT"
 #endif // VuiVertex_init
 
+#ifndef VuiVertex_pos
+#error "VuiVertex_pos must be defined when defining a custom VuiVertexT"
+#endif // VuiVertex_pos
+
 #ifndef VuiVertex_scale_pos
 #error "VuiVertex_scale_pos must be defined when defining a custom VuiVertexT"
 #endif // VuiVertex_scale_pos
 
+#ifndef VuiVertex_snap_pos
+#error "VuiVertex_snap_pos must be defined when defining a custom VuiVertexT"
+#endif // VuiVertex_snap_pos
+
+#if VUI_SDF_SHAPES && !defined(VuiVertex_init_sdf)
+#error "VuiVertex_init_sdf must be defined when defining a custom VuiVertexT with VUI_SDF_SHAPES enabled"
+#endif
+
 #ifndef VuiVertex_debug_fprintf
 #error "VuiVertex_debug_fprintf must be defined when defining a custom VuiVertexT"
 #endif // VuiVertex_debug_fprintf
 
+#endif
+
+#ifndef VuiVertex_init_glyph
+//
+// glyph textures only have the alpha channel, unless told otherwise the glyph is flagged by negating its uv.
+#define VuiVertex_init_glyph(pos_, uv_, color_) VuiVertex_init(pos_, VuiVec2_neg(uv_), color_)
 #endif
 typedef VuiVertexT VuiVertex;
 
 typedef struct {
 	VuiTextureId texture_id;
+	//
+	// the area of the window the command must be clipped to, scaled by the scale_factor.
+	// this is the whole window unless VuiSetup.scissor_clipping is enabled.
+	VuiRect clip_rect;
+	//
+	// the indices are relative to this vertex, so it must be added to each of them to index into VuiWindowRender.verts.
+	// eg. with OpenGL, pass this as the basevertex to glDrawElementsBaseVertex.
+	// it moves forward when the layer has more vertices than a VuiVertexIdx can address, see VuiVertexIdxT.
+	uint32_t verts_base_idx;
 	uint32_t verts_start_idx;
 	uint32_t indices_start_idx;
 	uint32_t indices_count;
 } VuiRenderCmd;
 
+//
+// this can be defined as uint16_t to halve the size of the indices.
+// when a layer has more vertices than fit in a uint16_t, a new command is started with its verts_base_idx at the next vertex.
 #ifndef VuiVertexIdxT
 #define VuiVertexIdxT uint32_t
 #endif
@@ -1117,6 +1332,11 @@ typedef struct {
     VuiStk(VuiVertex) verts;
 	VuiStk(VuiVertexIdx) indices;
     uint64_t hash;
+	//
+	// the areas of the window that have changed since the last call to vui_window_render.
+	// anything outside of these is the same as the last frame, so a backend can scissor
+	// and only redraw these. they are scaled by the scale_factor and do not overlap.
+	VuiStk(VuiRect) damage_rects;
 } VuiWindowRender;
 
 extern void vui_render_line(VuiVec2 start_pos, VuiVec2 end_pos, VuiColor color, float width);
@@ -1181,6 +1401,7 @@ extern VuiCtrlId vui_ctrl_get_id();
 extern VuiCtrlId vui_ctrl_get_prev_id();
 extern VuiCtrl* vui_ctrl_get(VuiCtrlId ctrl_id);
 extern VuiCtrl* vui_ctrl_try_get(VuiCtrlId ctrl_id);
+extern VuiCtrlCold* vui_ctrl_cold(VuiCtrl* ctrl);
 #define vui_ctrl_start(sib_id, styles) vui_ctrl_start_(sib_id, 0, 0, styles, NULL)
 extern void vui_ctrl_start_(VuiCtrlSibId sib_id, VuiCtrlFlags flags, VuiActiveChange active_change, const VuiCtrlStyle styles[VuiCtrlState_COUNT], VuiCtrlRenderFn render_fn);
 extern void vui_ctrl_end();
@@ -1458,6 +1679,43 @@ extern void vui_scroll_view_end();
 #define vui_text_box_multiline(sib_id, string_in_out, string_in_out_cap, flags, style) vui_text_box_multiline_(sib_id, string_in_out, string_in_out_cap, NULL, NULL, flags, style)
 extern VuiBool vui_text_box_multiline_(VuiCtrlSibId sib_id, char* string_in_out, uint32_t string_in_out_cap, VuiVec2* content_offset_in_out, VuiVec2* size_in_out, VuiScrollFlags flags, const VuiCtrlStyle styles[VuiCtrlState_COUNT]);
 
+// ====================================================================================
+//
+//
+// List View - a vertical scroll view that only builds the rows that are visible.
+//
+//
+// @param sib_id: the unique sibling identifier, see the vui_sib_id macro for more.
+// @param row_count: the total number of rows in the list.
+// @param row_height:
+//     the outer height of each row (including margin). this is used to work out the visible rows
+//     and the size of the scrollable content, so the rows that are not built still take up space.
+//     if your rows are not a fixed height, then pass an estimate.
+//
+// @param visible_start_idx_out, visible_end_idx_out:
+//     the range of rows that are visible. only build the rows from *visible_start_idx_out
+//     up to but not including *visible_end_idx_out between vui_list_view_start and vui_list_view_end.
+//
+// @param content_offset_in_out, size_in_out, flags: see vui_scroll_view_start_.
+//     VuiScrollFlags_vertical is always enabled.
+//
+// the rows are placed in a row layout with no layout spacing and use the scroll view styles.
+//
+// @example:
+//
+// uint32_t start_idx, end_idx;
+// vui_list_view_start(vui_sib_id, rows_count, 24.f, &start_idx, &end_idx, VuiScrollFlags_none, vui_ss.scroll_view);
+// for (uint32_t i = start_idx; i < end_idx; i += 1) {
+//     vui_scope_height(24.f)
+//     vui_text_button(i + 1, rows[i], vui_ss.button_action);
+// }
+// vui_list_view_end();
+//
+#define vui_list_view_start(sib_id, row_count, row_height, visible_start_idx_out, visible_end_idx_out, flags, style) \
+	vui_list_view_start_(sib_id, row_count, row_height, visible_start_idx_out, visible_end_idx_out, NULL, NULL, flags, style)
+extern void vui_list_view_start_(VuiCtrlSibId sib_id, uint32_t row_count, float row_height, uint32_t* visible_start_idx_out, uint32_t* visible_end_idx_out, VuiVec2* content_offset_in_out, VuiVec2* size_in_out, VuiScrollFlags flags, const VuiCtrlStyle styles[VuiCtrlState_COUNT]);
+extern void vui_list_view_end();
+
 // ====================================================================================
 //
 //
@@ -1502,6 +1760,40 @@ extern void vui_canvas_polyline(VuiVec2* points, uint32_t points_count, VuiColor
 extern void vui_canvas_convex_polygon(VuiVec2* points, uint32_t points_count, VuiColor color);
 extern void vui_canvas_bezier_curve(VuiVec2 points[4], VuiColor color, float width);
 
+// ====================================================================================
+//
+//
+// Cache - retain a subtree of controls that has not changed since the last frame.
+//
+//
+// @param sib_id: the unique sibling identifier, see the vui_sib_id macro for more.
+// @param content_hash:
+//     a hash of everything used to build the controls inside the cache.
+//     (text, values, images, style sheets, disabled state...)
+//     if this changes then the controls are rebuilt.
+//
+// @return:
+//     vui_true when the controls inside the cache need to be built.
+//     vui_false when the controls from the last frame are kept. in this case they are not laid out again
+//     if their position and size has not changed and the vertices from the last frame are reused when rendering.
+//
+// the cache is always rebuilt while the user is interacting with a control inside of it
+// or a style transition is in progress. popovers inside of a cache make it rebuild every frame.
+// the reused vertices keep their texture coordinates. they are dropped by vui_invalidate_glyphs,
+// which the glyph texture backend calls when it moves its glyphs and images, so include anything else
+// that moves an image in its texture in the content_hash.
+//
+// @example:
+//
+// if (vui_cache_start(vui_sib_id, inspector_hash)) {
+//     vui_row_layout();
+//     build_inspector();
+// }
+// vui_cache_end();
+//
+extern VuiBool vui_cache_start(VuiCtrlSibId sib_id, uint64_t content_hash);
+extern void vui_cache_end(void);
+
 // ===========================================================================================
 //
 //
@@ -1515,6 +1807,10 @@ typedef struct {
 	float height;
 	VuiTextureId texture_id;
 	VuiRect uv_rect;
+	//
+	// when true, the image is single channel coverage that is rendered like a glyph, so it is tinted by the image_tint.
+	// this lets small icons live in a glyph texture (see vui_stbtt_glyph_texture_add_image) and be drawn in the same command as text.
+	VuiBool is_alpha_mask;
 } VuiImage;
 
 extern VuiImageId vui_image_add(VuiImage* image);
@@ -1550,28 +1846,129 @@ typedef struct {
 	void* position_text_userdata;
 	uint16_t windows_count;
 	void* allocator;
+	//
+	// vui_init gives this to the text_header and text_menu styles of vui_ss, vui_context_create does not use it.
 	VuiFontId default_font_id;
 	uint32_t ctrls_init_cap;
+
+	//
+	// when enabled, vertices are no longer clamped to the clip rectangle on the CPU.
+	// instead a new VuiRenderCmd is started whenever the clip rectangle changes,
+	// and your backend must apply VuiRenderCmd.clip_rect (eg. with glScissor).
+	// this is cheaper and does not distort rounded shapes, circles and lines that cross the clip edge.
+	VuiBool scissor_clipping;
+
+	//
+	// when enabled, text sizes are remembered between frames so unchanged text is not measured again, see vui_text_size_cache_cap.
+	// only enable this if your position_text_fn does not rely on being called to measure every piece of text every frame.
+	// eg. vui_stbtt_position_text reports the glyphs it finds while measuring, so it needs glyphs that are kept across frames.
+	VuiBool text_size_cache;
 } VuiSetup;
 
 extern VuiBool vui_init(VuiSetup* setup);
 
+//
+// all of the state of VUI lives in a context and the API works on the current context of the calling thread.
+// every thread starts with the default context, which is the one vui_init sets up.
+// so an application with a single UI does not need to know about contexts.
+//
+// separate contexts share no state apart from the vui_ss stylesheet, which they only read,
+// so they can be built and rendered on different threads at the same time.
+// within a context, vui_window_render can be called for different windows on different threads at the same time,
+// but not while that context is building a frame. the position_text_fn and the allocator must then be thread safe.
+//
+// vui_context_create sets up a new context like vui_init does, but does not make it current.
+// unlike vui_init, it leaves vui_ss alone, so the default_font_id of its setup is not used by the vui_ss styles.
+typedef struct VuiContext VuiContext;
+extern VuiContext* vui_context_create(VuiSetup* setup);
+extern void vui_context_destroy(VuiContext* ctx);
+extern VuiContext* vui_context_current();
+//
+// pass NULL to go back to the default context.
+extern void vui_context_set_current(VuiContext* ctx);
+
 extern void vui_frame_start(VuiBool right_to_left, float dt);
 extern void vui_frame_end();
 
 extern void vui_window_start(VuiWindowId id, VuiVec2 size);
 extern void vui_window_end();
 
+//
+// when nothing the controls render from has changed since the last call,
+// the previous render is returned without being rebuilt and its damage_rects will be empty.
 extern VuiWindowRender* vui_window_render(VuiWindowId id, float scale_factor, VuiBool pixel_snapping);
+
+//
+// returns vui_true when called from inside of vui_window_render on this thread.
+// a backend can use this to leave its caches alone, while other windows may be rendering on other threads.
+extern VuiBool vui_window_is_rendering();
+
+//
+// call this while building a window when a control's render_fn depends on something
+// that VUI cannot see. eg. your own state or a font's glyphs being moved in their texture.
+// this will make the next vui_window_render rebuild the render instead of reusing the last one.
+extern void vui_window_invalidate_render();
+
+//
+// makes every cache build its controls again and every window render again, instead of reusing the last one.
+// unlike vui_window_invalidate_render, this can be called at any time outside of vui_window_render.
+// this only affects the current context, see vui_invalidate_glyphs to reach every context.
+extern void vui_invalidate_renders();
+
+//
+// like vui_invalidate_renders but for every context, and the text size caches of every context are cleared too.
+// call this when glyphs that are shared by the contexts have moved or are about to be removed from their texture.
+// eg. vui_stbtt_glyph_texture_pack calls this when it packs the whole texture. it can be called from any thread,
+// but not while a window that uses the glyphs is being rendered.
+extern void vui_invalidate_glyphs();
 extern void vui_window_set_mouse_focused(VuiWindowId id);
 extern void vui_window_set_focused(VuiWindowId id);
 
 extern void vui_window_dump_render(VuiWindowId id, FILE* file);
 
+//
+// the sizes of text are cached by the text, font, line height and word wrap width, see vui_text_size_cache_cap.
+// call vui_text_size_cache_clear when a font changes, so text of that font is measured again.
+typedef struct {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+	uint32_t count;
+	uint32_t cap;
+} VuiTextSizeCacheStats;
+extern VuiTextSizeCacheStats vui_text_size_cache_stats();
+extern void vui_text_size_cache_clear();
+
 // allocate zeroed memory that is cleared at the end of the frame.
 #define vui_frame_data_alloc_elmt(T) (T*)vui_frame_data_alloc(sizeof(T), alignof(T));
 extern void* vui_frame_data_alloc(uint32_t size, uint32_t align);
 
+// ===========================================================================================
+//
+//
+// atomics - for the few values that are shared between threads, the accesses are relaxed.
+//
+//
+// ===========================================================================================
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define _vui_atomic_load_u32(ptr) (*(volatile uint32_t*)(ptr))
+#define _vui_atomic_store_u32(ptr, value) (*(volatile uint32_t*)(ptr) = (value))
+#define _vui_atomic_store_u8(ptr, value) (*(volatile uint8_t*)(ptr) = (value))
+#define _vui_atomic_add_u32(ptr, value) _InterlockedExchangeAdd((volatile long*)(ptr), (long)(value))
+#elif defined(__GNUC__)
+#define _vui_atomic_load_u32(ptr) __atomic_load_n((uint32_t*)(ptr), __ATOMIC_RELAXED)
+#define _vui_atomic_store_u32(ptr, value) __atomic_store_n((uint32_t*)(ptr), (value), __ATOMIC_RELAXED)
+#define _vui_atomic_store_u8(ptr, value) __atomic_store_n((uint8_t*)(ptr), (value), __ATOMIC_RELAXED)
+#define _vui_atomic_add_u32(ptr, value) __atomic_fetch_add((uint32_t*)(ptr), (value), __ATOMIC_RELAXED)
+#else
+#define _vui_atomic_load_u32(ptr) (*(volatile uint32_t*)(ptr))
+#define _vui_atomic_store_u32(ptr, value) (*(volatile uint32_t*)(ptr) = (value))
+#define _vui_atomic_store_u8(ptr, value) (*(volatile uint8_t*)(ptr) = (value))
+#define _vui_atomic_add_u32(ptr, value) (*(volatile uint32_t*)(ptr) += (value))
+#endif
+
 // ===========================================================================================
 //
 //
@@ -1592,7 +1989,7 @@ struct _VuiPool {
 	uint32_t elmts_start_byte_idx;
 	uint32_t count;
 	uint32_t cap;
-	uint32_t free_list_head_id;
+	uint32_t free_search_idx; // every element below this index is allocated
 };
 
 #define VuiPool(T) VuiPool_##T
@@ -1603,7 +2000,7 @@ typedef struct { \
 	uint32_t elmts_start_byte_idx; \
 	uint32_t count; \
 	uint32_t cap; \
-	uint32_t free_list_head_id; \
+	uint32_t free_search_idx; \
 } VuiPool_##T;
 
 VuiBool _VuiPool_resize_cap(_VuiPool* pool, uint32_t new_cap, uintptr_t elmt_size, uintptr_t elmt_align);
@@ -1612,7 +2009,7 @@ void _VuiPool_init(_VuiPool* pool, uint32_t cap, uintptr_t elmt_size, uintptr_t
 void _VuiPool_deinit(_VuiPool* pool, uintptr_t elmt_size, uintptr_t elmt_align);
 void* _VuiPool_alloc(_VuiPool* pool, VuiPoolId* id_out, uintptr_t elmt_size, uintptr_t elmt_align);
 void _VuiPool_assert_id(_VuiPool* pool, uint32_t elmt_id);
-void _VuiPool_dealloc(_VuiPool* pool, uint32_t elmt_id, uintptr_t elmt_size, uintptr_t elmt_align);
+void _VuiPool_dealloc(_VuiPool* pool, uint32_t elmt_id);
 void* _VuiPool_id_to_ptr(_VuiPool* pool, VuiPoolId elmt_id, uintptr_t elmt_size);
 VuiPoolId _VuiPool_ptr_to_id(_VuiPool* pool, void* ptr, uintptr_t elmt_size);
 